@@ -0,0 +1,991 @@
+// Бенчмарки библиотеки s21_matrix_oop (Google Benchmark).
+// Запуск: make bench; результаты сохраняются в bench.json, и make
+// bench_compare сравнивает их с bench_baseline.json (см. Makefile)
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_file.h"
+#include "s21_matrix_fixed.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_out_of_core.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_solve.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_vector.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+template <typename T = double>
+S21BasicMatrix<T> RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21BasicMatrix<T> result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (T& x : result.row(i)) {
+      x = static_cast<T>(dist(gen));
+    }
+  }
+  return result;
+}
+
+// Скорость умножения n x n матриц в FLOP/s (2 * n^3 операций за итерацию)
+void SetGemmCounters(benchmark::State& state, int n) {
+  state.counters["FLOP/s"] = benchmark::Counter(
+      2.0 * n * n * n, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::kIs1000);
+}
+
+// Учебный цикл i-j-k, с которого начиналась библиотека: точка отсчета
+void BM_GemmTextbook(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double sum = 0;
+        for (int k = 0; k < n; ++k) {
+          sum += a(i, k) * b(k, j);
+        }
+        c(i, j) = sum;
+      }
+    }
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmTextbook)
+    ->RangeMultiplier(2)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_GemmNaive(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    S21GemmNaive(n, n, n, a.data(), a.GetStride(), b.data(), b.GetStride(),
+                 c.data(), c.GetStride());
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmNaive)
+    ->RangeMultiplier(2)
+    ->Range(64, 2048)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_GemmBlocked(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    S21GemmBlocked(n, n, n, a.data(), a.GetStride(), b.data(), b.GetStride(),
+                   c.data(), c.GetStride());
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmBlocked)
+    ->RangeMultiplier(2)
+    ->Range(64, 2048)
+    ->Unit(benchmark::kMillisecond);
+
+// Умножение и сложение в float и double: в векторном регистре float
+// помещается вдвое больше элементов, а матрица занимает вдвое меньше памяти
+template <typename T>
+void BM_GemmType(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<T> a = RandomMatrix<T>(n, n, 1);
+  S21BasicMatrix<T> b = RandomMatrix<T>(n, n, 2);
+  for (auto _ : state) {
+    S21BasicMatrix<T> c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK_TEMPLATE(BM_GemmType, float)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmType, double)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void BM_AddType(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<T> a = RandomMatrix<T>(n, n, 1);
+  S21BasicMatrix<T> b = RandomMatrix<T>(n, n, 2);
+  for (auto _ : state) {
+    a += b;
+    benchmark::DoNotOptimize(a.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * sizeof(T) * n * n);
+}
+BENCHMARK_TEMPLATE(BM_AddType, float)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_TEMPLATE(BM_AddType, double)->RangeMultiplier(4)->Range(64, 4096);
+
+// Штрассен-Виноград при разных точках перехода к блочному алгоритму.
+// FLOP/s считается по классическим 2 * n^3 операциям, поэтому значения
+// сравнимы с BM_GemmBlocked
+void BM_GemmStrassen(benchmark::State& state) {
+  const int crossover = static_cast<int>(state.range(0));
+  const int n = static_cast<int>(state.range(1));
+  const int saved = S21GetStrassenCrossover();
+  S21SetStrassenCrossover(crossover);
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  std::vector<double> workspace(S21StrassenWorkspaceSize(n, n, n));
+  for (auto _ : state) {
+    S21GemmStrassen(n, n, n, a.data(), a.GetStride(), b.data(), b.GetStride(),
+                    c.data(), c.GetStride(), workspace.data());
+    benchmark::DoNotOptimize(c.data());
+  }
+  S21SetStrassenCrossover(saved);
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmStrassen)
+    ->ArgsProduct({{128, 256, 512, 1024}, {1024, 2048, 4096}})
+    ->Unit(benchmark::kMillisecond);
+
+// Блочное умножение с ядрами конкретного набора инструкций
+void BM_GemmIsa(benchmark::State& state) {
+  const S21Isa isa = static_cast<S21Isa>(state.range(0));
+  const int n = static_cast<int>(state.range(1));
+  if (!S21IsaSupported(isa)) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+  const S21Isa saved = S21GetActiveIsa();
+  S21SetActiveIsa(isa);
+  state.SetLabel(S21GetKernels().name);
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    S21GemmBlocked(n, n, n, a.data(), a.GetStride(), b.data(), b.GetStride(),
+                   c.data(), c.GetStride());
+    benchmark::DoNotOptimize(c.data());
+  }
+  S21SetActiveIsa(saved);
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmIsa)
+    ->ArgsProduct({{static_cast<int>(S21Isa::kScalar),
+                    static_cast<int>(S21Isa::kSse2),
+                    static_cast<int>(S21Isa::kAvx2),
+                    static_cast<int>(S21Isa::kAvx512)},
+                   {256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+// Масштабирование блочного умножения по числу потоков общего пула
+void BM_GemmThreads(benchmark::State& state) {
+  const int threads = static_cast<int>(state.range(0));
+  const int n = static_cast<int>(state.range(1));
+  const int saved = S21GetThreadCount();
+  S21SetThreadCount(threads);
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    S21GemmBlocked(n, n, n, a.data(), a.GetStride(), b.data(), b.GetStride(),
+                   c.data(), c.GetStride());
+    benchmark::DoNotOptimize(c.data());
+  }
+  S21SetThreadCount(saved);
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_GemmThreads)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {2048}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_MulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_MulMatrix)
+    ->RangeMultiplier(4)
+    ->Range(4, 1024)
+    ->Unit(benchmark::kMicrosecond);
+
+// Цепочка a + b - c * 2.0 по шагам: каждый шаг — отдельный проход
+void BM_ChainEager(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c = RandomMatrix(n, n, 3);
+  for (auto _ : state) {
+    S21Matrix r(a);
+    r.SumMatrix(b);
+    S21Matrix t(c);
+    t.MulNumber(2.0);
+    r.SubMatrix(t);
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 4LL * n * n * sizeof(double));
+}
+BENCHMARK(BM_ChainEager)->RangeMultiplier(4)->Range(16, 4096);
+
+// Та же цепочка ленивым выражением: один проход без временных матриц
+void BM_ChainFused(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21Matrix c = RandomMatrix(n, n, 3);
+  for (auto _ : state) {
+    S21Matrix r = a + b - c * 2.0;
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 4LL * n * n * sizeof(double));
+}
+BENCHMARK(BM_ChainFused)->RangeMultiplier(4)->Range(16, 4096);
+
+}  // namespace
+
+// Малые преобразования: фиксированная матрица на стеке против
+// динамической с выделением памяти под каждый результат
+template <int N>
+void BM_SmallMulFixed(benchmark::State& state) {
+  const S21FixedMatrix<N, N> a(RandomMatrix(N, N, 1));
+  S21FixedMatrix<N, N> c = S21FixedMatrix<N, N>::Identity();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    c = a * c;
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK_TEMPLATE(BM_SmallMulFixed, 3);
+BENCHMARK_TEMPLATE(BM_SmallMulFixed, 4);
+
+template <int N>
+void BM_SmallMulDynamic(benchmark::State& state) {
+  S21Matrix a = RandomMatrix(N, N, 1);
+  S21Matrix c(N, N);
+  for (auto _ : state) {
+    c = a * c;
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_SmallMulDynamic, 3);
+BENCHMARK_TEMPLATE(BM_SmallMulDynamic, 4);
+
+template <int N>
+void BM_SmallInverseFixed(benchmark::State& state) {
+  S21FixedMatrix<N, N> a(RandomMatrix(N, N, 1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(a.InverseMatrix());
+  }
+}
+BENCHMARK_TEMPLATE(BM_SmallInverseFixed, 3);
+BENCHMARK_TEMPLATE(BM_SmallInverseFixed, 4);
+
+template <int N>
+void BM_SmallInverseDynamic(benchmark::State& state) {
+  S21Matrix a = RandomMatrix(N, N, 1);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_SmallInverseDynamic, 3);
+BENCHMARK_TEMPLATE(BM_SmallInverseDynamic, 4);
+
+// Матрица n x n, где ненулевой примерно каждый сотый элемент
+S21Matrix SparseMatrix(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21Matrix result(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (gen() % 100 == 0) {
+        result(i, j) = dist(gen);
+      }
+    }
+  }
+  return result;
+}
+
+// Произведение матрицы с плотностью 1% на плотный вектор: CSR против
+// плотного умножения на матрицу-столбец
+void BM_SpMV(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21SparseMatrix a(SparseMatrix(n, 1));
+  std::vector<double> x(n, 1.0);
+  for (auto _ : state) {
+    std::vector<double> y = a * x;
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+BENCHMARK(BM_SpMV)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_DenseMV(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = SparseMatrix(n, 1);
+  S21Matrix x(n, 1);
+  for (auto _ : state) {
+    S21Matrix y = a * x;
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+BENCHMARK(BM_DenseMV)->RangeMultiplier(4)->Range(256, 4096);
+
+// Разреженная на плотную матрицу n x 64
+void BM_SpMM(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21SparseMatrix a(SparseMatrix(n, 1));
+  S21Matrix b = RandomMatrix(n, 64, 2);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+BENCHMARK(BM_SpMM)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_DenseMM(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = SparseMatrix(n, 1);
+  S21Matrix b = RandomMatrix(n, 64, 2);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+BENCHMARK(BM_DenseMM)->RangeMultiplier(4)->Range(256, 4096);
+
+// Пакет из count случайных матриц n x n
+S21MatrixBatch RandomBatch(int count, int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21MatrixBatch result(count, n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double* plane = result.Plane(i, j);
+      for (int l = 0; l < count; ++l) {
+        plane[l] = dist(gen);
+      }
+    }
+  }
+  return result;
+}
+
+// Число обработанных матриц в секунду
+void SetMatrixCounters(benchmark::State& state, int count) {
+  state.counters["matrices/s"] = benchmark::Counter(
+      count, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Операции над пакетом из 4096 матриц порядка range(0) против цикла по
+// отдельным S21Matrix
+constexpr int kBatchCount = 4096;
+
+void BM_BatchMul(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21MatrixBatch a = RandomBatch(kBatchCount, n, 1);
+  S21MatrixBatch b = RandomBatch(kBatchCount, n, 2);
+  for (auto _ : state) {
+    S21MatrixBatch c = a * b;
+    benchmark::DoNotOptimize(c.Plane(0, 0));
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_BatchMul)->DenseRange(2, 4);
+
+void BM_LoopMul(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> a, b;
+  for (int l = 0; l < kBatchCount; ++l) {
+    a.push_back(RandomMatrix(n, n, 2 * l));
+    b.push_back(RandomMatrix(n, n, 2 * l + 1));
+  }
+  for (auto _ : state) {
+    for (int l = 0; l < kBatchCount; ++l) {
+      S21Matrix c = a[l] * b[l];
+      benchmark::DoNotOptimize(c.data());
+    }
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_LoopMul)->DenseRange(2, 4);
+
+void BM_BatchAdd(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21MatrixBatch a = RandomBatch(kBatchCount, n, 1);
+  S21MatrixBatch b = RandomBatch(kBatchCount, n, 2);
+  for (auto _ : state) {
+    a += b;
+    benchmark::DoNotOptimize(a.Plane(0, 0));
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_BatchAdd)->DenseRange(2, 4);
+
+void BM_BatchDeterminant(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21MatrixBatch a = RandomBatch(kBatchCount, n, 1);
+  for (auto _ : state) {
+    std::vector<double> det = a.Determinant();
+    benchmark::DoNotOptimize(det.data());
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_BatchDeterminant)->DenseRange(2, 4);
+
+void BM_BatchInverse(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21MatrixBatch a = RandomBatch(kBatchCount, n, 1);
+  for (auto _ : state) {
+    S21MatrixBatch inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Plane(0, 0));
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_BatchInverse)->DenseRange(2, 4);
+
+void BM_LoopInverse(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> a;
+  for (int l = 0; l < kBatchCount; ++l) {
+    a.push_back(RandomMatrix(n, n, l));
+  }
+  for (auto _ : state) {
+    for (int l = 0; l < kBatchCount; ++l) {
+      S21Matrix inverse = a[l].InverseMatrix();
+      benchmark::DoNotOptimize(inverse.data());
+    }
+  }
+  SetMatrixCounters(state, kBatchCount);
+}
+BENCHMARK(BM_LoopInverse)->DenseRange(2, 4);
+
+// Файл матрицы n x n: запись, отображение (O(1), не зависит от n) и
+// полное чтение через отображение с копией в S21Matrix
+const char kBenchFile[] = "bench_matrix.bin";
+
+void BM_SaveFile(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (auto _ : state) {
+    a.SaveFile(kBenchFile);
+  }
+  state.SetBytesProcessed(state.iterations() * n * a.GetStride() * 8);
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_SaveFile)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_MapFile(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  RandomMatrix(n, n, 1).SaveFile(kBenchFile);
+  for (auto _ : state) {
+    S21MappedMatrix mapped = S21Matrix::MapFile(kBenchFile);
+    benchmark::DoNotOptimize(mapped(n - 1, n - 1));
+  }
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_MapFile)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_LoadFile(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  RandomMatrix(n, n, 1).SaveFile(kBenchFile);
+  for (auto _ : state) {
+    S21Matrix a(S21Matrix::MapFile(kBenchFile).View());
+    benchmark::DoNotOptimize(a.data());
+  }
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_LoadFile)->RangeMultiplier(4)->Range(256, 4096);
+
+// Матрица над отображением без копирования элементов
+void BM_AdoptFile(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  RandomMatrix(n, n, 1).SaveFile(kBenchFile);
+  for (auto _ : state) {
+    S21Matrix a(S21Matrix::MapFile(kBenchFile));
+    benchmark::DoNotOptimize(static_cast<const S21Matrix&>(a)(n - 1, n - 1));
+  }
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_AdoptFile)->RangeMultiplier(4)->Range(256, 4096);
+
+// Умножение n x n матриц из файлов с бюджетом памяти range(1) МБ;
+// сравнивается с BM_MulMatrix того же размера
+void BM_MultiplyFiles(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const std::size_t budget = static_cast<std::size_t>(state.range(1)) << 20;
+  RandomMatrix(n, n, 1).SaveFile("bench_a.bin");
+  RandomMatrix(n, n, 2).SaveFile("bench_b.bin");
+  for (auto _ : state) {
+    S21OutOfCoreStats stats = S21MultiplyFiles<double>(
+        "bench_a.bin", "bench_b.bin", "bench_c.bin", budget);
+    state.counters["tile"] = stats.tile_rows;
+  }
+  SetGemmCounters(state, n);
+  std::remove("bench_a.bin");
+  std::remove("bench_b.bin");
+  std::remove("bench_c.bin");
+}
+BENCHMARK(BM_MultiplyFiles)
+    ->ArgsProduct({{1024, 2048}, {4, 16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+// Цикл с временными матрицами n x n: сумма, копия и произведение на
+// каждой итерации. range(1) = 1 — буферы берутся из пула S21PoolScope,
+// 0 — из системного распределителя; счетчик mallocs — обращений к системе
+// на итерацию
+void BM_Temporaries(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  S21BufferPool pool;
+  S21AllocatorScope scope(state.range(1) != 0 ? &pool : nullptr);
+  const long long before = S21SystemAllocator()->GetStats().allocations;
+  for (auto _ : state) {
+    S21Matrix sum = a + b;
+    S21Matrix copy(sum);
+    copy.MulMatrix(b);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.counters["mallocs"] = benchmark::Counter(
+      static_cast<double>(S21SystemAllocator()->GetStats().allocations -
+                          before),
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Temporaries)->ArgsProduct({{4, 16, 64}, {0, 1}});
+
+// Базовый набор: каждая операция S21Matrix на размерах от 2 до 4096.
+// Сравнение двух прогонов: make bench, затем make bench_compare (см.
+// bench_compare.py)
+
+// Поэлементные операции и копирование — все степени двойки
+void ElementwiseSizes(benchmark::internal::Benchmark* bench) {
+  bench->RangeMultiplier(2)->Range(2, 4096);
+}
+
+// Операции за O(n^3) — через одну степень двойки
+void CubicSizes(benchmark::internal::Benchmark* bench) {
+  bench->RangeMultiplier(4)->Range(2, 4096)->Unit(benchmark::kMicrosecond);
+}
+
+// Байты, которые операция читает и пишет за итерацию: matrices матриц
+// n x n
+void SetMatrixBytes(benchmark::State& state, int n, int matrices) {
+  state.SetBytesProcessed(state.iterations() * matrices * n * n *
+                          static_cast<long long>(sizeof(double)));
+}
+
+void BM_Construct(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    S21Matrix a(n, n);
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetMatrixBytes(state, n, 1);
+}
+BENCHMARK(BM_Construct)->Apply(ElementwiseSizes);
+
+void BM_Copy(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (auto _ : state) {
+    S21Matrix copy(a);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetMatrixBytes(state, n, 2);
+}
+BENCHMARK(BM_Copy)->Apply(ElementwiseSizes);
+
+void BM_CopyAssign(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix copy(n, n);
+  for (auto _ : state) {
+    copy = a;
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetMatrixBytes(state, n, 2);
+}
+BENCHMARK(BM_CopyAssign)->Apply(ElementwiseSizes);
+
+void BM_Move(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(a));
+    a = std::move(moved);
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+BENCHMARK(BM_Move)->Apply(ElementwiseSizes);
+
+// Операция op(a, b) над матрицами n x n; matrices — сколько матриц она
+// читает и пишет
+template <typename Op>
+void BM_Elementwise(benchmark::State& state, int matrices, Op op) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  for (auto _ : state) {
+    op(a, b);
+    benchmark::ClobberMemory();
+  }
+  SetMatrixBytes(state, n, matrices);
+}
+// Операции на месте повторяются над одной матрицей; множитель -1 не дает
+// значениям расти
+BENCHMARK_CAPTURE(BM_Elementwise, SumMatrix, 3,
+                  [](S21Matrix& a, S21Matrix& b) { a.SumMatrix(b); })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, SubMatrix, 3,
+                  [](S21Matrix& a, S21Matrix& b) { a.SubMatrix(b); })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, MulNumber, 2,
+                  [](S21Matrix& a, S21Matrix&) { a.MulNumber(-1.0); })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, Plus, 3,
+                  [](S21Matrix& a, S21Matrix& b) {
+                    S21Matrix c = a + b;
+                    benchmark::DoNotOptimize(c.data());
+                  })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, Minus, 3,
+                  [](S21Matrix& a, S21Matrix& b) {
+                    S21Matrix c = a - b;
+                    benchmark::DoNotOptimize(c.data());
+                  })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, TimesNumber, 2,
+                  [](S21Matrix& a, S21Matrix&) {
+                    S21Matrix c = a * -1.0;
+                    benchmark::DoNotOptimize(c.data());
+                  })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, PlusAssign, 3,
+                  [](S21Matrix& a, S21Matrix& b) { a += b; })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, MinusAssign, 3,
+                  [](S21Matrix& a, S21Matrix& b) { a -= b; })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, TimesNumberAssign, 2,
+                  [](S21Matrix& a, S21Matrix&) { a *= -1.0; })
+    ->Apply(ElementwiseSizes);
+// Равные матрицы: сравнение проходит обе матрицы целиком
+BENCHMARK_CAPTURE(BM_Elementwise, Equal, 2,
+                  [](S21Matrix& a, S21Matrix&) {
+                    benchmark::DoNotOptimize(a == a);
+                  })
+    ->Apply(ElementwiseSizes);
+BENCHMARK_CAPTURE(BM_Elementwise, Transpose, 2,
+                  [](S21Matrix& a, S21Matrix&) {
+                    S21Matrix t = a.Transpose();
+                    benchmark::DoNotOptimize(t.data());
+                  })
+    ->Apply(ElementwiseSizes);
+
+// Операция op(a, b) за O(n^3) над матрицами n x n
+template <typename Op>
+void BM_Cubic(benchmark::State& state, Op op) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  for (auto _ : state) {
+    op(a, b);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK_CAPTURE(BM_Cubic, Times, [](S21Matrix& a, S21Matrix& b) {
+  S21Matrix c = a * b;
+  benchmark::DoNotOptimize(c.data());
+})->Apply(CubicSizes);
+// Включает копию a: без нее значения росли бы от итерации к итерации
+BENCHMARK_CAPTURE(BM_Cubic, TimesAssign, [](S21Matrix& a, S21Matrix& b) {
+  S21Matrix c(a);
+  c *= b;
+  benchmark::DoNotOptimize(c.data());
+})->Apply(CubicSizes);
+BENCHMARK_CAPTURE(BM_Cubic, Determinant, [](S21Matrix& a, S21Matrix&) {
+  benchmark::DoNotOptimize(a.Determinant());
+})->Apply(CubicSizes);
+BENCHMARK_CAPTURE(BM_Cubic, InverseMatrix, [](S21Matrix& a, S21Matrix&) {
+  S21Matrix inverse = a.InverseMatrix();
+  benchmark::DoNotOptimize(inverse.data());
+})->Apply(CubicSizes);
+BENCHMARK_CAPTURE(BM_Cubic, CalcComplements, [](S21Matrix& a, S21Matrix&) {
+  S21Matrix complements = a.CalcComplements();
+  benchmark::DoNotOptimize(complements.data());
+})->Apply(CubicSizes);
+
+// Транспонирование на месте квадратной матрицы n x n
+void BM_TransposeInPlace(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetMatrixBytes(state, n, 2);
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(ElementwiseSizes);
+
+// A^T * B: range(1) = 1 — ленивый вид TransposeView, 0 — явная копия
+// Transpose
+void BM_MulTransposed(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix b = RandomMatrix(n, n, 2);
+  for (auto _ : state) {
+    S21Matrix c = state.range(1) != 0 ? a.TransposeView() * b
+                                      : a.Transpose() * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  SetGemmCounters(state, n);
+}
+BENCHMARK(BM_MulTransposed)
+    ->ArgsProduct({{64, 256, 1024, 2048}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Одна правая часть для симметричной положительно определенной n x n:
+// range(1) = 0 — InverseMatrix() * b, 1 — Solve (разложение на каждом
+// вызове), 2 — решение готовым LU, 3 — готовым разложением Холецкого
+void BM_SolveVector(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix r = RandomMatrix(n, n, 1);
+  S21Matrix a = r.TransposeView() * r;
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  S21Matrix b = RandomMatrix(n, 1, 2);
+  std::vector<double> vector_b(n);
+  for (int i = 0; i < n; ++i) {
+    vector_b[i] = b(i, 0);
+  }
+  const S21LU lu(a);
+  const S21Cholesky cholesky(a);
+  for (auto _ : state) {
+    switch (state.range(1)) {
+      case 0: {
+        S21Matrix x = a.InverseMatrix() * b;
+        benchmark::DoNotOptimize(x.data());
+        break;
+      }
+      case 1:
+        benchmark::DoNotOptimize(a.Solve(vector_b).data());
+        break;
+      case 2:
+        benchmark::DoNotOptimize(lu.Solve(vector_b).data());
+        break;
+      default:
+        benchmark::DoNotOptimize(cholesky.Solve(vector_b).data());
+    }
+  }
+}
+BENCHMARK(BM_SolveVector)
+    ->ArgsProduct({{64, 256, 1024}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Разложения n x n без решения: LU, Холецкий, QR
+void BM_Factorize(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix r = RandomMatrix(n, n, 1);
+  S21Matrix a = r.TransposeView() * r;
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  for (auto _ : state) {
+    switch (state.range(1)) {
+      case 0:
+        benchmark::DoNotOptimize(S21LU(a).GetLU().data());
+        break;
+      case 1:
+        benchmark::DoNotOptimize(S21Cholesky(a).GetL().data());
+        break;
+      default:
+        benchmark::DoNotOptimize(S21QR(a).IsFullRank());
+    }
+  }
+}
+BENCHMARK(BM_Factorize)
+    ->ArgsProduct({{64, 256, 1024}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Треугольное решение n x n с m правыми частями: range(2) = 1 — A^T
+void BM_SolveTriangular(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const int m = static_cast<int>(state.range(1));
+  const S21Transpose trans =
+      state.range(2) != 0 ? S21Transpose::kYes : S21Transpose::kNo;
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (int i = 0; i < n; ++i) {
+    a(i, i) = n;
+  }
+  S21Matrix b = RandomMatrix(n, m, 2);
+  for (auto _ : state) {
+    S21Matrix x(b);
+    S21SolveTriangular(S21Triangle::kLower, trans, false, n, m, a.data(),
+                       a.GetStride(), x.data(), x.GetStride());
+    benchmark::DoNotOptimize(x.data());
+  }
+  // n^2 умножений и сложений на столбец
+  state.counters["FLOP/s"] = benchmark::Counter(
+      1.0 * n * n * m, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::kIs1000);
+}
+BENCHMARK(BM_SolveTriangular)
+    ->ArgsProduct({{256, 1024}, {1, 16, 256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Матрица n x n на вектор: range(1) = 0 — произведение на матрицу n x 1,
+// 1 — S21Gemv в готовый вектор, 2 — S21Gemv с A^T, 3 — S21Ger
+void BM_Gemv(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  S21Matrix column = RandomMatrix(n, 1, 2);
+  S21Vector x(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = column(i, 0);
+  }
+  S21Vector y(n);
+  for (auto _ : state) {
+    switch (state.range(1)) {
+      case 0: {
+        S21Matrix product = a * column;
+        benchmark::DoNotOptimize(product.data());
+        break;
+      }
+      case 1:
+        S21Gemv(S21Transpose::kNo, 1.0, a, x, 0.0, &y);
+        break;
+      case 2:
+        S21Gemv(S21Transpose::kYes, 1.0, a, x, 0.0, &y);
+        break;
+      default:
+        S21Ger(1e-9, x, y, &a);
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(a.data());
+  }
+  SetMatrixBytes(state, n, 1);
+}
+BENCHMARK(BM_Gemv)
+    ->ArgsProduct({{64, 256, 1024, 4096}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMicrosecond);
+
+// A^k для стохастической n x n: range(2) = 0 — k умножений *=,
+// 1 — Pow(k)
+void BM_Pow(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const int k = static_cast<int>(state.range(1));
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i) {
+    a(i, i) = 0.5;
+    a(i, (i + 1) % n) = 0.5;
+  }
+  for (auto _ : state) {
+    if (state.range(2) == 0) {
+      S21Matrix power(a);
+      for (int step = 1; step < k; ++step) {
+        power *= a;
+      }
+      benchmark::DoNotOptimize(power.data());
+    } else {
+      S21Matrix power = a.Pow(k);
+      benchmark::DoNotOptimize(power.data());
+    }
+  }
+}
+BENCHMARK(BM_Pow)
+    ->ArgsProduct({{16, 128, 512}, {16, 100}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Expm(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (auto _ : state) {
+    S21Matrix exponential = a.Expm();
+    benchmark::DoNotOptimize(exponential.data());
+  }
+}
+BENCHMARK(BM_Expm)->RangeMultiplier(4)->Range(4, 1024)->Unit(
+    benchmark::kMicrosecond);
+
+// Задержка одного вызова для матриц порядка 1-5: до 4 включительно
+// работают явные формулы, 5 — общий алгоритм для сравнения
+template <class Op>
+void BM_SmallOrder(benchmark::State& state, Op op) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  for (auto _ : state) {
+    op(a);
+  }
+}
+BENCHMARK_CAPTURE(BM_SmallOrder, Determinant, [](S21Matrix& a) {
+  benchmark::DoNotOptimize(a.Determinant());
+})->DenseRange(1, 5);
+BENCHMARK_CAPTURE(BM_SmallOrder, CalcComplements, [](S21Matrix& a) {
+  S21Matrix complements = a.CalcComplements();
+  benchmark::DoNotOptimize(complements.data());
+})->DenseRange(1, 5);
+BENCHMARK_CAPTURE(BM_SmallOrder, InverseMatrix, [](S21Matrix& a) {
+  S21Matrix inverse = a.InverseMatrix();
+  benchmark::DoNotOptimize(inverse.data());
+})->DenseRange(1, 5);
+
+// Повторные запросы к неизменной матрице с кэшем производных величин
+// (второй аргумент 1) и без него
+template <class Op>
+void BM_Cache(benchmark::State& state, Op op) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  a.EnableCache(state.range(1) != 0);
+  for (auto _ : state) {
+    op(a);
+  }
+}
+BENCHMARK_CAPTURE(BM_Cache, Determinant, [](S21Matrix& a) {
+  benchmark::DoNotOptimize(a.Determinant());
+})->ArgsProduct({{16, 128, 512}, {0, 1}})->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Cache, InverseMatrix, [](S21Matrix& a) {
+  S21Matrix inverse = a.InverseMatrix();
+  benchmark::DoNotOptimize(inverse.data());
+})->ArgsProduct({{16, 128, 512}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Копия, из которой только читают, в обычном режиме и с копированием
+// при записи (второй аргумент 1)
+void BM_CopyOnWrite(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 1);
+  a.EnableCopyOnWrite(state.range(1) != 0);
+  for (auto _ : state) {
+    S21Matrix copy(a);
+    benchmark::DoNotOptimize(static_cast<const S21Matrix&>(copy)(0, 0));
+  }
+}
+BENCHMARK(BM_CopyOnWrite)
+    ->ArgsProduct({{16, 256, 2048}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Сравнение двух прогонов бенчмарков s21_matrix_oop.
+
+Принимает JSON-файлы Google Benchmark (make bench пишет bench.json) и
+печатает для каждого общего бенчмарка время в базовом и новом прогоне и
+относительное изменение. Если бенчмарк запускался с повторами
+(--benchmark_repetitions), берется медиана повторов.
+
+Код возврата 1, если хотя бы один бенчмарк замедлился больше порога:
+так сравнение можно встроить в проверку между коммитами.
+
+Пример:
+    cp bench.json bench_baseline.json
+    ... изменения ...
+    make bench && make bench_compare
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+# Множители для перевода времени в наносекунды
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    """Возвращает {имя бенчмарка: время в нс} из файла path."""
+    with open(path, encoding="utf-8") as file:
+        data = json.load(file)
+    medians = {}
+    samples = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        time = bench[metric] * UNITS[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[name] = time
+        else:
+            samples.setdefault(name, []).append(time)
+    result = {name: statistics.median(times)
+              for name, times in samples.items()}
+    result.update(medians)
+    return result
+
+
+def format_time(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= UNITS[unit]:
+            return f"{ns / UNITS[unit]:.3g} {unit}"
+    return f"{ns:.3g} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="JSON базового прогона")
+    parser.add_argument("contender", help="JSON нового прогона")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"),
+                        default="real_time", help="сравниваемое время")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="допустимое замедление, доля (0.10 = 10%%)")
+    parser.add_argument("--filter", default="",
+                        help="сравнивать только бенчмарки с этой подстрокой")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+    names = [name for name in contender
+             if name in baseline and args.filter in name]
+    if not names:
+        print("No common benchmarks to compare", file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in names)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>10}  {'Contender':>10}"
+          f"  {'Change':>8}")
+    regressions = []
+    for name in names:
+        old, new = baseline[name], contender[name]
+        change = (new - old) / old if old > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  SLOWER"
+            regressions.append(name)
+        elif change < -args.threshold:
+            mark = "  faster"
+        print(f"{name:<{width}}  {format_time(old):>10}  "
+              f"{format_time(new):>10}  {change:>+8.1%}{mark}")
+
+    only_old = sorted(set(baseline) - set(contender))
+    only_new = sorted(set(contender) - set(baseline))
+    if only_old:
+        print(f"\nOnly in baseline: {len(only_old)} benchmarks")
+    if only_new:
+        print(f"Only in contender: {len(only_new)} benchmarks")
+    if regressions:
+        print(f"\n{len(regressions)} benchmarks slower by more than "
+              f"{args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,179 @@
+#include "s21_matrix_alloc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+namespace {
+
+// Системный распределитель: выровненный operator new. Счетчики атомарны,
+// так как им пользуются все потоки
+class SystemAllocator : public S21Allocator {
+ public:
+  void* Allocate(std::size_t bytes, std::size_t alignment) override {
+    void* buffer = ::operator new(bytes, std::align_val_t{alignment});
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+    return buffer;
+  }
+
+  void Deallocate(void* buffer, std::size_t,
+                  std::size_t alignment) noexcept override {
+    ::operator delete(buffer, std::align_val_t{alignment});
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  S21AllocatorStats GetStats() const override {
+    S21AllocatorStats stats{};
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    stats.system_allocations = stats.allocations;
+    stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void ResetStats() override {
+    allocations_ = 0;
+    bytes_ = 0;
+    deallocations_ = 0;
+  }
+
+ private:
+  std::atomic<long long> allocations_{0};
+  std::atomic<long long> bytes_{0};
+  std::atomic<long long> deallocations_{0};
+};
+
+// Распределитель текущего потока; nullptr — системный
+thread_local S21Allocator* t_allocator = nullptr;
+
+}  // namespace
+
+S21Allocator* S21SystemAllocator() {
+  // Не уничтожается: матрицы в статических объектах освобождаются позже
+  static SystemAllocator* const allocator = new SystemAllocator;
+  return allocator;
+}
+
+S21Allocator* S21GetAllocator() {
+  return t_allocator != nullptr ? t_allocator : S21SystemAllocator();
+}
+
+void S21SetAllocator(S21Allocator* allocator) { t_allocator = allocator; }
+
+S21BufferPool::S21BufferPool(std::size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes) {}
+
+S21BufferPool::~S21BufferPool() { Release(); }
+
+std::size_t S21BufferPool::ClassBytes(std::size_t bytes) {
+  std::size_t high = kAlignment;
+  while (high <= bytes / 2) {
+    high *= 2;
+  }
+  const std::size_t step = std::max(high / 4, kAlignment);
+  return std::max((bytes + step - 1) / step * step, kAlignment);
+}
+
+int S21BufferPool::ClassIndex(std::size_t class_bytes) {
+  int power = 0;
+  while ((class_bytes >> power) > 1) {
+    ++power;
+  }
+  const std::size_t high = std::size_t{1} << power;
+  return 4 * power + static_cast<int>((class_bytes - high) / (high / 4));
+}
+
+void* S21BufferPool::Allocate(std::size_t bytes, std::size_t alignment) {
+  const bool pooled = alignment <= kAlignment;
+  const std::size_t class_bytes = ClassBytes(bytes);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.allocations;
+    stats_.bytes += static_cast<long long>(bytes);
+    std::vector<void*>& bucket = free_[ClassIndex(class_bytes)];
+    if (pooled && !bucket.empty()) {
+      void* buffer = bucket.back();
+      bucket.pop_back();
+      cached_bytes_ -= class_bytes;
+      ++stats_.pool_hits;
+      return buffer;
+    }
+    ++stats_.system_allocations;
+  }
+  // Система вызывается вне блокировки. Буфер выделяется на весь класс,
+  // чтобы потом подойти любому запросу того же класса
+  if (!pooled) {
+    return S21SystemAllocator()->Allocate(bytes, alignment);
+  }
+  return S21SystemAllocator()->Allocate(class_bytes, kAlignment);
+}
+
+void S21BufferPool::Deallocate(void* buffer, std::size_t bytes,
+                               std::size_t alignment) noexcept {
+  const bool pooled = alignment <= kAlignment;
+  const std::size_t class_bytes = ClassBytes(bytes);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.deallocations;
+    if (pooled && cached_bytes_ + class_bytes <= max_cached_bytes_) {
+      // push_back бросает только при нехватке памяти; тогда буфер
+      // возвращается системе
+      try {
+        free_[ClassIndex(class_bytes)].push_back(buffer);
+        cached_bytes_ += class_bytes;
+        return;
+      } catch (const std::bad_alloc&) {
+      }
+    }
+  }
+  if (!pooled) {
+    S21SystemAllocator()->Deallocate(buffer, bytes, alignment);
+  } else {
+    S21SystemAllocator()->Deallocate(buffer, class_bytes, kAlignment);
+  }
+}
+
+S21AllocatorStats S21BufferPool::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void S21BufferPool::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = S21AllocatorStats{};
+}
+
+std::size_t S21BufferPool::GetCachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+
+void S21BufferPool::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int index = 0; index < kClassCount; ++index) {
+    if (free_[index].empty()) {
+      continue;
+    }
+    // Размер класса восстанавливается по номеру
+    const std::size_t high = std::size_t{1} << (index / 4);
+    const std::size_t class_bytes = high + index % 4 * (high / 4);
+    for (void* buffer : free_[index]) {
+      S21SystemAllocator()->Deallocate(buffer, class_bytes, kAlignment);
+    }
+    free_[index].clear();
+  }
+  cached_bytes_ = 0;
+}
+
+S21AllocatorScope::S21AllocatorScope(S21Allocator* allocator)
+    : previous_(t_allocator) {
+  S21SetAllocator(allocator);
+}
+
+S21AllocatorScope::~S21AllocatorScope() { S21SetAllocator(previous_); }
+
+S21PoolScope::S21PoolScope(std::size_t max_cached_bytes)
+    : pool_(max_cached_bytes), scope_(&pool_) {}
+
+S21BufferPool& S21PoolScope::Pool() { return pool_; }
@@ -0,0 +1,148 @@
+#ifndef S21_MATRIX_ALLOC_H
+#define S21_MATRIX_ALLOC_H
+
+// Распределители памяти для буферов S21Matrix. По умолчанию буфер каждой
+// матрицы выделяется системным распределителем (выровненный operator new).
+// В циклах, где на каждой итерации создаются и уничтожаются временные
+// матрицы одних и тех же размеров, можно подключить пул S21BufferPool:
+// освобожденные буферы остаются в пуле по классам размеров и выдаются
+// снова без обращения к системе.
+//
+// Распределитель выбирается для каждого потока отдельно
+// (S21AllocatorScope, S21PoolScope). Матрица запоминает распределитель,
+// из которого получила буфер, и возвращает буфер туда же, даже если
+// освобождается в другом потоке или после выхода из области. Поэтому
+// распределитель должен жить дольше всех матриц, получивших из него
+// память.
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Счетчики распределителя с момента создания или ResetStats
+struct S21AllocatorStats {
+  // Выдано буферов и их суммарный запрошенный размер в байтах
+  long long allocations;
+  long long bytes;
+  // Сколько буферов выдано из пула без обращения к системе
+  long long pool_hits;
+  // Обращений к системному распределителю
+  long long system_allocations;
+  // Возвращено буферов
+  long long deallocations;
+};
+
+// Интерфейс распределителя буферов матриц
+class S21Allocator {
+ public:
+  virtual ~S21Allocator() = default;
+
+  // Выделяет bytes байт с выравниванием alignment (степень двойки).
+  // Содержимое не определено. Бросает std::bad_alloc
+  virtual void* Allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+  // Возвращает буфер, выделенный Allocate с теми же bytes и alignment
+  virtual void Deallocate(void* buffer, std::size_t bytes,
+                          std::size_t alignment) noexcept = 0;
+
+  virtual S21AllocatorStats GetStats() const = 0;
+  virtual void ResetStats() = 0;
+};
+
+// Системный распределитель, общий для всех потоков. Его счетчик
+// system_allocations учитывает и обращения пулов к системе, поэтому
+// показывает все выделения памяти под матрицы
+S21Allocator* S21SystemAllocator();
+
+// Распределитель, из которого текущий поток выделяет буферы новых матриц
+S21Allocator* S21GetAllocator();
+
+// Назначает распределитель текущего потока; nullptr — системный
+void S21SetAllocator(S21Allocator* allocator);
+
+// Пул буферов по классам размеров. Размер округляется вверх до четверти
+// старшей степени двойки (не меньше 64 байт), поэтому буферы близких
+// размеров попадают в один класс. Начиная с 256 байт запас памяти не
+// превышает 25%; меньшие размеры округляются до кратного 64 байтам, и
+// запас доходит до 63 байт (65 байт занимают 128).
+// Свободные буферы пул держит, пока их суммарный размер не больше
+// max_cached_bytes; остальные сразу возвращаются системе. Методы можно
+// вызывать из разных потоков
+class S21BufferPool : public S21Allocator {
+ public:
+  static constexpr std::size_t kDefaultMaxCachedBytes = std::size_t{1} << 28;
+
+  explicit S21BufferPool(std::size_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  // Возвращает системе свободные буферы. Буферы, выданные пулом, к этому
+  // времени должны быть возвращены
+  ~S21BufferPool() override;
+
+  S21BufferPool(const S21BufferPool&) = delete;
+  S21BufferPool& operator=(const S21BufferPool&) = delete;
+
+  void* Allocate(std::size_t bytes, std::size_t alignment) override;
+  void Deallocate(void* buffer, std::size_t bytes,
+                  std::size_t alignment) noexcept override;
+  S21AllocatorStats GetStats() const override;
+  void ResetStats() override;
+
+  // Суммарный размер свободных буферов в пуле
+  std::size_t GetCachedBytes() const;
+
+  // Возвращает системе все свободные буферы
+  void Release();
+
+ private:
+  // Наибольшее выравнивание, которое дают буферы пула; для большего
+  // пул обращается к системе напрямую
+  static constexpr std::size_t kAlignment = 64;
+  // Классы: по четыре на каждую степень двойки размера
+  static constexpr int kClassCount = 4 * 64;
+
+  // Размер класса для запроса в bytes байт и номер класса
+  static std::size_t ClassBytes(std::size_t bytes);
+  static int ClassIndex(std::size_t class_bytes);
+
+  mutable std::mutex mutex_;
+  std::vector<void*> free_[kClassCount];
+  std::size_t max_cached_bytes_;
+  std::size_t cached_bytes_ = 0;
+  S21AllocatorStats stats_{};
+};
+
+// Область, в которой текущий поток выделяет буферы матриц из allocator.
+// На выходе восстанавливает прежний распределитель потока
+class S21AllocatorScope {
+ public:
+  explicit S21AllocatorScope(S21Allocator* allocator);
+  ~S21AllocatorScope();
+
+  S21AllocatorScope(const S21AllocatorScope&) = delete;
+  S21AllocatorScope& operator=(const S21AllocatorScope&) = delete;
+
+ private:
+  S21Allocator* previous_;
+};
+
+// Арена: собственный пул, подключенный к текущему потоку на время
+// области. На выходе пул возвращает системе все накопленные буферы, поэтому
+// матрицы, созданные в области, должны быть уничтожены до выхода из нее
+class S21PoolScope {
+ public:
+  explicit S21PoolScope(
+      std::size_t max_cached_bytes = S21BufferPool::kDefaultMaxCachedBytes);
+
+  S21PoolScope(const S21PoolScope&) = delete;
+  S21PoolScope& operator=(const S21PoolScope&) = delete;
+
+  S21BufferPool& Pool();
+
+ private:
+  // Пул объявлен первым: он уничтожается после восстановления
+  // распределителя потока
+  S21BufferPool pool_;
+  S21AllocatorScope scope_;
+};
+
+#endif  // S21_MATRIX_ALLOC_H
@@ -0,0 +1,300 @@
+#include "s21_matrix_batch.h"
+
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols) {
+  if (count <= 0) {
+    throw std::invalid_argument("Batch size must be greater than zero");
+  }
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Number of rows and columns must be greater than zero");
+  }
+  // Буфер выровнен на 64 байта, поэтому каждая плоскость начинается на
+  // границе строки кеша.
+  // При шаге, кратном 4 КБ, одноименные элементы всех плоскостей попадают
+  // в одно множество кеша и вытесняют друг друга, поэтому такой шаг
+  // удлиняется на строку кеша
+  constexpr int kLanes = 64 / sizeof(T);
+  constexpr int kPage = 4096 / sizeof(T);
+  stride_ = (count + kLanes - 1) / kLanes * kLanes;
+  if (stride_ % kPage == 0) {
+    stride_ += kLanes;
+  }
+  data_ = S21BasicVector<T>(stride_ * rows * cols);
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCount() const {
+  return count_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetStride() const {
+  return stride_;
+}
+
+template <typename T>
+std::size_t S21BasicMatrixBatch<T>::Offset(int index, int i, int j) const {
+  if (index < 0 || index >= count_ || i < 0 || i >= rows_ || j < 0 ||
+      j >= cols_) {
+    throw std::out_of_range("Matrix batch indices are out of range");
+  }
+  return static_cast<std::size_t>(i * cols_ + j) * stride_ + index;
+}
+
+template <typename T>
+T& S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  return data_[Offset(index, i, j)];
+}
+
+template <typename T>
+const T& S21BasicMatrixBatch<T>::operator()(int index, int i, int j) const {
+  return data_[Offset(index, i, j)];
+}
+
+template <typename T>
+T* S21BasicMatrixBatch<T>::Plane(int i, int j) {
+  return data_.data() + Offset(0, i, j);
+}
+
+template <typename T>
+const T* S21BasicMatrixBatch<T>::Plane(int i, int j) const {
+  return data_.data() + Offset(0, i, j);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  Offset(index, 0, 0);
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      result(i, j) =
+          data_[static_cast<std::size_t>(i * cols_ + j) * stride_ + index];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T>& matrix) {
+  Offset(index, 0, 0);
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::invalid_argument(
+        "Matrix must have the same dimensions as the batch.");
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      data_[static_cast<std::size_t>(i * cols_ + j) * stride_ + index] =
+          matrix(i, j);
+    }
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::CheckSameShape(
+    const S21BasicMatrixBatch& other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Batches must have the same size and matrix dimensions.");
+  }
+}
+
+template <typename T>
+bool S21BasicMatrixBatch<T>::EqMatrix(const S21BasicMatrixBatch& other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    return false;
+  }
+  for (int k = 0; k < rows_ * cols_; ++k) {
+    const std::size_t offset = static_cast<std::size_t>(k) * stride_;
+    if (!S21KernelEqual(count_, data_.data() + offset,
+                        other.data_.data() + offset,
+                        S21MatrixTraits<T>::kEpsilon)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::SumMatrix(const S21BasicMatrixBatch& other) {
+  CheckSameShape(other);
+  for (int k = 0; k < rows_ * cols_; ++k) {
+    const std::size_t offset = static_cast<std::size_t>(k) * stride_;
+    S21KernelAdd(count_, data_.data() + offset, other.data_.data() + offset);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::SubMatrix(const S21BasicMatrixBatch& other) {
+  CheckSameShape(other);
+  for (int k = 0; k < rows_ * cols_; ++k) {
+    const std::size_t offset = static_cast<std::size_t>(k) * stride_;
+    S21KernelSub(count_, data_.data() + offset, other.data_.data() + offset);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulNumber(const T num) {
+  for (int k = 0; k < rows_ * cols_; ++k) {
+    S21KernelScale(count_, data_.data() + static_cast<std::size_t>(k) * stride_,
+                   num);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch& other) {
+  *this = *this * other;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Determinant can only be calculated for square matrices.");
+  }
+  std::vector<T> result(count_);
+  if (rows_ > kClosedFormMaxOrder) {
+    for (int l = 0; l < count_; ++l) {
+      result[l] = Get(l).Determinant();
+    }
+    return result;
+  }
+  const auto& kernels = S21GetKernels<T>();
+  S21ParallelFor(count_, static_cast<long long>(count_) * rows_ * rows_,
+                 [&](int begin, int end) {
+                   kernels.batch_det(end - begin, rows_, data_.data() + begin,
+                                     result.data() + begin, stride_);
+                 });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Inverse matrix can only be calculated for square matrices.");
+  }
+  S21BasicMatrixBatch result(count_, rows_, cols_);
+  if (rows_ > kClosedFormMaxOrder) {
+    for (int l = 0; l < count_; ++l) {
+      result.Set(l, Get(l).InverseMatrix());
+    }
+    return result;
+  }
+  std::vector<T> det(count_);
+  const auto& kernels = S21GetKernels<T>();
+  S21ParallelFor(count_, static_cast<long long>(count_) * rows_ * rows_,
+                 [&](int begin, int end) {
+                   kernels.batch_inverse(end - begin, rows_,
+                                         data_.data() + begin,
+                                         result.data_.data() + begin,
+                                         det.data() + begin, stride_);
+                 });
+  for (T d : det) {
+    if (d == 0) {
+      throw std::invalid_argument(
+          "Inverse matrix does not exist for singular matrices (determinant is "
+          "zero).");
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator+(
+    const S21BasicMatrixBatch& other) const {
+  S21BasicMatrixBatch result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator-(
+    const S21BasicMatrixBatch& other) const {
+  S21BasicMatrixBatch result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator*(
+    const S21BasicMatrixBatch& other) const {
+  if (count_ != other.count_) {
+    throw std::invalid_argument("Batches must have the same size.");
+  }
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
+  S21BasicMatrixBatch result(count_, rows_, other.cols_);
+  const auto& kernels = S21GetKernels<T>();
+  const long long work =
+      static_cast<long long>(count_) * rows_ * cols_ * other.cols_;
+  S21ParallelFor(count_, work, [&](int begin, int end) {
+    kernels.batch_mul(end - begin, rows_, other.cols_, cols_,
+                      data_.data() + begin, other.data_.data() + begin,
+                      result.data_.data() + begin, stride_);
+  });
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator*(T num) const {
+  S21BasicMatrixBatch result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template <typename T>
+bool S21BasicMatrixBatch<T>::operator==(
+    const S21BasicMatrixBatch& other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator+=(
+    const S21BasicMatrixBatch& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator-=(
+    const S21BasicMatrixBatch& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator*=(
+    const S21BasicMatrixBatch& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>& S21BasicMatrixBatch<T>::operator*=(T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
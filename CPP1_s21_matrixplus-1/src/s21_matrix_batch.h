@@ -0,0 +1,103 @@
+#ifndef S21_MATRIX_BATCH_H
+#define S21_MATRIX_BATCH_H
+
+// Пакет из count матриц одного размера rows x cols в виде структуры
+// массивов: одноименные элементы всех матриц лежат подряд, элемент (i, j)
+// матрицы l — в data[(i * cols + j) * stride + l]. Операции над пакетом
+// выполняются векторными ядрами (см. s21_matrix_kernels.h), у которых
+// каждый регистр охватывает несколько соседних матриц, поэтому тысячи
+// матриц 2x2 - 4x4 обрабатываются без выделения памяти на каждую.
+// Пакет собран для float и double.
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_vector.h"
+
+template <typename T>
+class S21BasicMatrixBatch {
+  static_assert(kS21HasKernels<T>,
+                "Matrix batches are available for float and double only");
+
+ public:
+  using value_type = T;
+
+  // Пакет из count нулевых матриц rows x cols
+  S21BasicMatrixBatch(int count, int rows, int cols);
+
+  int GetCount() const;
+  int GetRows() const;
+  int GetCols() const;
+
+  // Расстояние между плоскостями соседних элементов: count, округленное
+  // вверх до 64 байт и не кратное 4 КБ
+  int GetStride() const;
+
+  // Элемент (i, j) матрицы index
+  T& operator()(int index, int i, int j);
+  const T& operator()(int index, int i, int j) const;
+
+  // Плоскость элемента (i, j): GetCount() значений подряд, по одному на
+  // матрицу
+  T* Plane(int i, int j);
+  const T* Plane(int i, int j) const;
+
+  // Копия матрицы index
+  S21BasicMatrix<T> Get(int index) const;
+
+  // Записывает matrix на место матрицы index
+  void Set(int index, const S21BasicMatrix<T>& matrix);
+
+  // Совпадают ли размеры пакетов и все матрицы с допуском EqMatrix
+  bool EqMatrix(const S21BasicMatrixBatch& other) const;
+
+  // Поэлементные операции над каждой парой матриц с одинаковым номером
+  void SumMatrix(const S21BasicMatrixBatch& other);
+  void SubMatrix(const S21BasicMatrixBatch& other);
+  void MulNumber(const T num);
+
+  // Каждая матрица умножается на матрицу other с тем же номером
+  void MulMatrix(const S21BasicMatrixBatch& other);
+
+  // Определители всех матриц. До порядка 4 — явными формулами сразу по
+  // всему пакету, для больших порядков — по одной матрице
+  std::vector<T> Determinant() const;
+
+  // Обратные матрицы. Бросает std::invalid_argument, если хотя бы одна
+  // матрица вырождена
+  S21BasicMatrixBatch InverseMatrix() const;
+
+  S21BasicMatrixBatch operator+(const S21BasicMatrixBatch& other) const;
+  S21BasicMatrixBatch operator-(const S21BasicMatrixBatch& other) const;
+  S21BasicMatrixBatch operator*(const S21BasicMatrixBatch& other) const;
+  S21BasicMatrixBatch operator*(T num) const;
+  bool operator==(const S21BasicMatrixBatch& other) const;
+  S21BasicMatrixBatch& operator+=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator-=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator*=(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch& operator*=(T num);
+
+ private:
+  // Наибольший порядок, для которого есть явные формулы в ядрах
+  static constexpr int kClosedFormMaxOrder = 4;
+
+  // Проверяет, что пакеты одинаковы по числу и размеру матриц
+  void CheckSameShape(const S21BasicMatrixBatch& other) const;
+
+  // Проверяет индексы и возвращает смещение элемента
+  std::size_t Offset(int index, int i, int j) const;
+
+  int count_, rows_, cols_, stride_;
+  // Выровненный на 64 байта буфер из распределителя S21GetAllocator
+  S21BasicVector<T> data_;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+using S21MatrixBatchF = S21BasicMatrixBatch<float>;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+
+#endif  // S21_MATRIX_BATCH_H
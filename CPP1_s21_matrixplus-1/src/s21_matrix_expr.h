@@ -0,0 +1,223 @@
+#ifndef S21_MATRIX_EXPR_H
+#define S21_MATRIX_EXPR_H
+
+// Ленивые выражения над матрицами (expression templates). Операторы +, -
+// и умножение на число не считают результат сразу, а возвращают легкий
+// объект-узел, который хранит ссылки на операнды. Вся цепочка
+// (например, a + b - c * 2.0) вычисляется одним проходом по памяти при
+// присваивании в матрицу, без промежуточных матриц. Тип элементов узла
+// (value_type) совпадает с типом элементов операндов.
+//
+// Узел знает свои размеры (GetRows, GetCols) и по номеру строки отдает
+// курсор Row(i), у которого operator[](j) возвращает элемент (i, j).
+// Элемент (i, j) узла доступен через operator(), поэтому
+// auto sum = a + b; sum(0, 0) работает как с матрицей. Узел хранит
+// ссылки только на матрицы-lvalue: операторы с временной матрицей
+// (s21_matrix_oop.h) считают результат сразу и возвращают матрицу,
+// поэтому auto r = S21Matrix(...) + b не ссылается на уничтоженный
+// операнд. Узел остается действительным, пока живут матрицы-переменные,
+// из которых он построен.
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class S21BasicMatrix;
+
+// Базовый класс выражений (CRTP). От него наследуются узлы и матрицы,
+// что позволяет операторам принимать любые их сочетания
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+
+  // Элемент (i, j) выражения; бросает std::out_of_range для индексов вне
+  // матрицы. Матрица определяет собственный operator()
+  auto operator()(int i, int j) const {
+    const E& self = Self();
+    if (i < 0 || i >= self.GetRows() || j < 0 || j >= self.GetCols()) {
+      throw std::out_of_range("Matrix indices are out of range");
+    }
+    return self.Row(i)[j];
+  }
+
+ protected:
+  S21MatrixExpr() = default;
+  ~S21MatrixExpr() = default;
+};
+
+// Лист выражения: ссылка на матрицу. Шаблон по M нужен только для того,
+// чтобы матрица могла быть неполным типом в этом заголовке
+template <typename M>
+class S21MatrixLeaf : public S21MatrixExpr<S21MatrixLeaf<M>> {
+ public:
+  using value_type = typename M::value_type;
+
+  explicit S21MatrixLeaf(const M& matrix) : matrix_(matrix) {}
+
+  int GetRows() const { return matrix_.GetRows(); }
+  int GetCols() const { return matrix_.GetCols(); }
+  const value_type* Row(int i) const {
+    return matrix_.data() + static_cast<std::size_t>(i) * matrix_.GetStride();
+  }
+
+ private:
+  const M& matrix_;
+};
+
+// Как узел хранит операнд: матрица — через лист со ссылкой, остальные
+// узлы — по значению (они маленькие и могут быть временными)
+template <typename E>
+struct S21ExprOperand {
+  using Type = E;
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  using Type = S21MatrixLeaf<S21BasicMatrix<T>>;
+};
+
+// Поэлементные бинарные операции
+struct S21ExprAdd {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct S21ExprSub {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a - b;
+  }
+};
+
+// Поэлементная операция над двумя выражениями одинакового размера
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExpr<S21MatrixBinaryExpr<L, R, Op>> {
+  static_assert(std::is_same_v<typename L::value_type,
+                               typename R::value_type>,
+                "Operands must have the same element type");
+
+ public:
+  using value_type = typename L::value_type;
+
+  template <typename LRow, typename RRow>
+  struct RowCursor {
+    LRow left;
+    RRow right;
+    value_type operator[](int j) const {
+      return Op::Apply(left[j], right[j]);
+    }
+  };
+
+  S21MatrixBinaryExpr(const L& left, const R& right)
+      : left_(left), right_(right) {
+    // Размеры проверяются сразу, как и в SumMatrix / SubMatrix
+    if (left_.GetRows() != right_.GetRows() ||
+        left_.GetCols() != right_.GetCols()) {
+      throw std::invalid_argument(
+          "Matrices must have the same dimensions for addition.");
+    }
+  }
+
+  int GetRows() const { return left_.GetRows(); }
+  int GetCols() const { return left_.GetCols(); }
+  auto Row(int i) const {
+    using LRow = decltype(left_.Row(i));
+    using RRow = decltype(right_.Row(i));
+    return RowCursor<LRow, RRow>{left_.Row(i), right_.Row(i)};
+  }
+
+ private:
+  typename S21ExprOperand<L>::Type left_;
+  typename S21ExprOperand<R>::Type right_;
+};
+
+// Выражение, умноженное на число
+template <typename E>
+class S21MatrixScaledExpr : public S21MatrixExpr<S21MatrixScaledExpr<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+  template <typename ERow>
+  struct RowCursor {
+    ERow row;
+    value_type num;
+    value_type operator[](int j) const { return row[j] * num; }
+  };
+
+  S21MatrixScaledExpr(const E& expr, value_type num)
+      : expr_(expr), num_(num) {}
+
+  int GetRows() const { return expr_.GetRows(); }
+  int GetCols() const { return expr_.GetCols(); }
+  auto Row(int i) const {
+    using ERow = decltype(expr_.Row(i));
+    return RowCursor<ERow>{expr_.Row(i), num_};
+  }
+
+ private:
+  typename S21ExprOperand<E>::Type expr_;
+  value_type num_;
+};
+
+// Записывает строки [begin, end) выражения в буфер с шагом stride.
+// Строка обходится блоками по kExprBlock элементов: все чтения блока
+// выполняются до записи, поэтому компилятор сворачивает блок в векторные
+// инструкции даже при -O2 и при совпадении буфера с операндом
+constexpr int kExprBlock = 8;
+
+template <typename E, typename T>
+void S21EvalRows(const E& expr, int begin, int end, T* dst, int stride) {
+  const int cols = expr.GetCols();
+  for (int i = begin; i < end; ++i) {
+    const auto row = expr.Row(i);
+    T* out = dst + static_cast<std::size_t>(i) * stride;
+    int j = 0;
+    for (; j + kExprBlock <= cols; j += kExprBlock) {
+      T block[kExprBlock];
+#pragma GCC unroll 8
+      for (int t = 0; t < kExprBlock; ++t) {
+        block[t] = row[j + t];
+      }
+#pragma GCC unroll 8
+      for (int t = 0; t < kExprBlock; ++t) {
+        out[j + t] = block[t];
+      }
+    }
+    for (; j < cols; ++j) {
+      out[j] = row[j];
+    }
+  }
+}
+
+// Операторы выражений
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21ExprAdd> operator+(const S21MatrixExpr<L>& left,
+                                                const S21MatrixExpr<R>& right) {
+  return S21MatrixBinaryExpr<L, R, S21ExprAdd>(left.Self(), right.Self());
+}
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21ExprSub> operator-(const S21MatrixExpr<L>& left,
+                                                const S21MatrixExpr<R>& right) {
+  return S21MatrixBinaryExpr<L, R, S21ExprSub>(left.Self(), right.Self());
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(const S21MatrixExpr<E>& expr,
+                                 const typename E::value_type num) {
+  return S21MatrixScaledExpr<E>(expr.Self(), num);
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(const typename E::value_type num,
+                                 const S21MatrixExpr<E>& expr) {
+  return S21MatrixScaledExpr<E>(expr.Self(), num);
+}
+
+#endif  // S21_MATRIX_EXPR_H
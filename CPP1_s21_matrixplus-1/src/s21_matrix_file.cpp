@@ -0,0 +1,399 @@
+#include "s21_matrix_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+template <typename T>
+constexpr S21MatrixDtype DtypeOf() {
+  if constexpr (std::is_same_v<T, float>) {
+    return S21MatrixDtype::kFloat32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return S21MatrixDtype::kFloat64;
+  } else if constexpr (std::is_same_v<T, long double>) {
+    return S21MatrixDtype::kLongDouble;
+  } else if constexpr (std::is_same_v<T, int>) {
+    static_assert(sizeof(int) == 4, "int32 files require a 32-bit int");
+    return S21MatrixDtype::kInt32;
+  } else {
+    static_assert(std::is_same_v<T, std::int64_t>, "Unsupported type");
+    return S21MatrixDtype::kInt64;
+  }
+}
+
+constexpr std::uint32_t kAlignment = 64;
+
+// Шаг строки в файле: как у S21BasicMatrix, целое число строк кэша
+template <typename T>
+int FileStride(int cols) {
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  return (cols + per_line - 1) / per_line * per_line;
+}
+
+std::runtime_error FileError(const std::string& what, const std::string& path) {
+  return std::runtime_error(what + ": " + path);
+}
+
+// "Распределитель" буфера матрицы, забравшей отображение файла: буфер
+// возвращается снятием отображения, после чего объект удаляет себя.
+// Каждое отображение получает свой объект, а матрица возвращает буфер
+// ровно один раз
+class MappingOwner final : public S21Allocator {
+ public:
+  MappingOwner(void* base, std::size_t length) : base_(base), length_(length) {}
+
+  void* Allocate(std::size_t, std::size_t) override { throw std::bad_alloc(); }
+
+  void Deallocate(void*, std::size_t, std::size_t) noexcept override {
+    munmap(base_, length_);
+    delete this;
+  }
+
+  S21AllocatorStats GetStats() const override { return {}; }
+  void ResetStats() override {}
+
+ private:
+  void* base_;
+  std::size_t length_;
+};
+
+// Открытый дескриптор, который закрывается при выходе из области
+class FileDescriptor {
+ public:
+  explicit FileDescriptor(int fd) : fd_(fd) {}
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+  int get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+}  // namespace
+
+template <typename T>
+S21MatrixFileHeader S21MakeFileHeader(int rows, int cols) {
+  S21MatrixFileHeader header{};
+  std::memcpy(header.magic, S21MatrixFileHeader::kMagic, sizeof(header.magic));
+  header.version = S21MatrixFileHeader::kVersion;
+  header.byte_order = S21MatrixFileHeader::kByteOrderMark;
+  header.rows = static_cast<std::uint64_t>(rows);
+  header.cols = static_cast<std::uint64_t>(cols);
+  header.stride = static_cast<std::uint64_t>(FileStride<T>(cols));
+  header.dtype = DtypeOf<T>();
+  header.element_size = sizeof(T);
+  header.alignment = kAlignment;
+  header.data_offset = sizeof(header);
+  return header;
+}
+
+template <typename T>
+void S21CheckFileHeader(const S21MatrixFileHeader& header, std::size_t length,
+                        const std::string& path) {
+  const char* error = nullptr;
+  if (std::memcmp(header.magic, S21MatrixFileHeader::kMagic,
+                  sizeof(header.magic)) != 0) {
+    error = "Not a matrix file";
+  } else if (header.version != S21MatrixFileHeader::kVersion) {
+    error = "Unsupported matrix file version";
+  } else if (header.byte_order != S21MatrixFileHeader::kByteOrderMark) {
+    error = "Matrix file has a different byte order";
+  } else if (header.dtype != DtypeOf<T>() ||
+             header.element_size != sizeof(T)) {
+    error = "Matrix file has a different element type";
+  } else if (header.rows == 0 || header.cols == 0 ||
+             header.rows > INT32_MAX || header.stride > INT32_MAX ||
+             header.cols > header.stride ||
+             // Строки выровнены хотя бы как у S21BasicMatrix, и данные
+             // начинаются после заголовка на границе выравнивания
+             header.alignment < kAlignment ||
+             (header.alignment & (header.alignment - 1)) != 0 ||
+             header.stride * sizeof(T) % header.alignment != 0 ||
+             header.data_offset < sizeof(S21MatrixFileHeader) ||
+             header.data_offset % header.alignment != 0) {
+    error = "Matrix file header is corrupted";
+  } else if (length < header.data_offset ||
+             (length - header.data_offset) / sizeof(T) / header.stride <
+                 header.rows) {
+    error = "Matrix file is truncated";
+  }
+  if (error != nullptr) {
+    throw FileError(error, path);
+  }
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(const std::string& path,
+                                              S21MapMode mode)
+    : base_(nullptr),
+      length_(0),
+      mode_(mode),
+      rows_(0),
+      cols_(0),
+      stride_(0),
+      data_(nullptr) {
+  const FileDescriptor fd(open(path.c_str(), O_RDONLY));
+  if (fd.get() < 0) {
+    throw FileError(std::strerror(errno), path);
+  }
+  struct stat info;
+  if (fstat(fd.get(), &info) != 0) {
+    throw FileError(std::strerror(errno), path);
+  }
+  const std::size_t length = static_cast<std::size_t>(info.st_size);
+  if (length < sizeof(S21MatrixFileHeader)) {
+    throw FileError("File is too short for a matrix header", path);
+  }
+
+  // Копирование при записи — частное отображение с правом записи:
+  // измененные страницы копируются ядром, файл не меняется
+  const int protection =
+      mode == S21MapMode::kCopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+  void* base = mmap(nullptr, length, protection, MAP_PRIVATE, fd.get(), 0);
+  if (base == MAP_FAILED) {
+    throw FileError(std::strerror(errno), path);
+  }
+  base_ = base;
+  length_ = length;
+
+  S21MatrixFileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  try {
+    S21CheckFileHeader<T>(header, length, path);
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+  rows_ = static_cast<int>(header.rows);
+  cols_ = static_cast<int>(header.cols);
+  stride_ = static_cast<int>(header.stride);
+  data_ = reinterpret_cast<T*>(static_cast<char*>(base) + header.data_offset);
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(
+    S21BasicMappedMatrix&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      length_(std::exchange(other.length_, 0)),
+      mode_(other.mode_),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      stride_(std::exchange(other.stride_, 0)),
+      data_(std::exchange(other.data_, nullptr)) {}
+
+template <typename T>
+S21BasicMappedMatrix<T>& S21BasicMappedMatrix<T>::operator=(
+    S21BasicMappedMatrix&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    base_ = std::exchange(other.base_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+    mode_ = other.mode_;
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    stride_ = std::exchange(other.stride_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicMappedMatrix<T>::~S21BasicMappedMatrix() {
+  Unmap();
+}
+
+template <typename T>
+void S21BasicMappedMatrix<T>::Unmap() {
+  if (base_ != nullptr) {
+    munmap(base_, length_);
+    base_ = nullptr;
+  }
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+int S21BasicMappedMatrix<T>::GetStride() const {
+  return stride_;
+}
+
+template <typename T>
+S21MapMode S21BasicMappedMatrix<T>::GetMode() const {
+  return mode_;
+}
+
+template <typename T>
+const T* S21BasicMappedMatrix<T>::data() const {
+  return data_;
+}
+
+template <typename T>
+const T& S21BasicMappedMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return data_[static_cast<std::size_t>(i) * stride_ + j];
+}
+
+template <typename T>
+S21BasicConstMatrixView<T> S21BasicMappedMatrix<T>::View() const {
+  return S21BasicConstMatrixView<T>(data_, rows_, cols_, stride_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMappedMatrix<T>::MutableView() {
+  if (mode_ != S21MapMode::kCopyOnWrite) {
+    throw std::logic_error("Read-only matrix mapping cannot be modified");
+  }
+  return S21BasicMatrixView<T>(data_, rows_, cols_, stride_);
+}
+
+template <typename T>
+S21Allocator* S21BasicMappedMatrix<T>::Release() {
+  // Частное отображение можно сделать записываемым: файл не изменится
+  if (mode_ == S21MapMode::kReadOnly &&
+      mprotect(base_, length_, PROT_READ | PROT_WRITE) != 0) {
+    throw std::runtime_error(std::strerror(errno));
+  }
+  S21Allocator* owner = new MappingOwner(base_, length_);
+  base_ = nullptr;
+  length_ = 0;
+  rows_ = 0;
+  cols_ = 0;
+  stride_ = 0;
+  data_ = nullptr;
+  return owner;
+}
+
+template <typename T>
+S21BasicMatrixWriter<T>::S21BasicMatrixWriter(const std::string& path,
+                                              int rows, int cols)
+    : rows_(rows), cols_(cols), stride_(FileStride<T>(cols)),
+      rows_written_(0) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Number of rows and columns must be greater than zero");
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    throw FileError("Cannot create matrix file", path);
+  }
+  const S21MatrixFileHeader header = S21MakeFileHeader<T>(rows, cols);
+  out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+template <typename T>
+S21BasicMatrixWriter<T>::~S21BasicMatrixWriter() = default;
+
+template <typename T>
+void S21BasicMatrixWriter<T>::WriteRow(const T* row) {
+  if (rows_written_ == rows_) {
+    throw std::out_of_range("All rows of the matrix file are written");
+  }
+  out_.write(reinterpret_cast<const char*>(row), sizeof(T) * cols_);
+  // Нули до конца строки, чтобы следующая началась с границы 64 байт
+  static const T kPadding[kAlignment / sizeof(T)] = {};
+  out_.write(reinterpret_cast<const char*>(kPadding),
+             sizeof(T) * (stride_ - cols_));
+  ++rows_written_;
+}
+
+template <typename T>
+int S21BasicMatrixWriter<T>::GetRowsWritten() const {
+  return rows_written_;
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Close() {
+  if (rows_written_ != rows_) {
+    throw std::runtime_error("Matrix file is incomplete: " +
+                             std::to_string(rows_written_) + " of " +
+                             std::to_string(rows_) + " rows written");
+  }
+  out_.close();
+  if (!out_) {
+    throw std::runtime_error("Error writing matrix file");
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SaveFile(const std::string& path) const {
+  S21BasicMatrixWriter<T> writer(path, rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    writer.WriteRow(RowPtr(i));
+  }
+  writer.Close();
+}
+
+template <typename T>
+S21BasicMappedMatrix<T> S21BasicMatrix<T>::MapFile(const std::string& path,
+                                                   S21MapMode mode) {
+  return S21BasicMappedMatrix<T>(path, mode);
+}
+
+template class S21BasicMappedMatrix<float>;
+template class S21BasicMappedMatrix<double>;
+template class S21BasicMappedMatrix<long double>;
+template class S21BasicMappedMatrix<int>;
+template class S21BasicMappedMatrix<std::int64_t>;
+template class S21BasicMatrixWriter<float>;
+template class S21BasicMatrixWriter<double>;
+template class S21BasicMatrixWriter<long double>;
+template class S21BasicMatrixWriter<int>;
+template class S21BasicMatrixWriter<std::int64_t>;
+
+template void S21BasicMatrix<float>::SaveFile(const std::string&) const;
+template void S21BasicMatrix<double>::SaveFile(const std::string&) const;
+template void S21BasicMatrix<long double>::SaveFile(const std::string&) const;
+template void S21BasicMatrix<int>::SaveFile(const std::string&) const;
+template void S21BasicMatrix<std::int64_t>::SaveFile(const std::string&) const;
+template S21BasicMappedMatrix<float> S21BasicMatrix<float>::MapFile(
+    const std::string&, S21MapMode);
+template S21BasicMappedMatrix<double> S21BasicMatrix<double>::MapFile(
+    const std::string&, S21MapMode);
+template S21BasicMappedMatrix<long double>
+S21BasicMatrix<long double>::MapFile(const std::string&, S21MapMode);
+template S21BasicMappedMatrix<int> S21BasicMatrix<int>::MapFile(
+    const std::string&, S21MapMode);
+template S21BasicMappedMatrix<std::int64_t>
+S21BasicMatrix<std::int64_t>::MapFile(const std::string&, S21MapMode);
+
+template S21MatrixFileHeader S21MakeFileHeader<float>(int, int);
+template S21MatrixFileHeader S21MakeFileHeader<double>(int, int);
+template S21MatrixFileHeader S21MakeFileHeader<long double>(int, int);
+template S21MatrixFileHeader S21MakeFileHeader<int>(int, int);
+template S21MatrixFileHeader S21MakeFileHeader<std::int64_t>(int, int);
+template void S21CheckFileHeader<float>(const S21MatrixFileHeader&,
+                                        std::size_t, const std::string&);
+template void S21CheckFileHeader<double>(const S21MatrixFileHeader&,
+                                         std::size_t, const std::string&);
+template void S21CheckFileHeader<long double>(const S21MatrixFileHeader&,
+                                              std::size_t, const std::string&);
+template void S21CheckFileHeader<int>(const S21MatrixFileHeader&, std::size_t,
+                                      const std::string&);
+template void S21CheckFileHeader<std::int64_t>(const S21MatrixFileHeader&,
+                                               std::size_t,
+                                               const std::string&);
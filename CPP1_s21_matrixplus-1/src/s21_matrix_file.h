@@ -0,0 +1,166 @@
+#ifndef S21_MATRIX_FILE_H
+#define S21_MATRIX_FILE_H
+
+// Двоичный формат файла матрицы. Файл начинается с заголовка
+// S21MatrixFileHeader размером 64 байта, за ним со смещения data_offset
+// идут rows строк по stride элементов: cols значений и нули до
+// выравнивания строки на 64 байта. Строки лежат так же, как в памяти
+// S21BasicMatrix, поэтому отображенный файл читается без преобразования
+// и передается в функции, принимающие указатель и шаг строки.
+//
+// Элементы хранятся в порядке байтов записавшего компьютера; заголовок
+// хранит метку порядка, и файл с чужим порядком байтов не открывается.
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_view.h"
+
+// Тип элементов в файле
+enum class S21MatrixDtype : std::uint32_t {
+  kFloat32 = 1,
+  kFloat64 = 2,
+  kLongDouble = 3,
+  kInt32 = 4,
+  kInt64 = 5
+};
+
+struct S21MatrixFileHeader {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+  static constexpr std::uint32_t kVersion = 1;
+  // Записывается в порядке байтов компьютера: при чтении на компьютере
+  // с другим порядком получается другое число
+  static constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  // Шаг строки в элементах
+  std::uint64_t stride;
+  S21MatrixDtype dtype;
+  // sizeof элемента: long double различается между платформами
+  std::uint32_t element_size;
+  // Выравнивание строк в байтах
+  std::uint32_t alignment;
+  // Смещение первой строки от начала файла
+  std::uint32_t data_offset;
+  char reserved[8];
+};
+
+static_assert(sizeof(S21MatrixFileHeader) == 64,
+              "Matrix file header must occupy 64 bytes");
+
+// Заголовок файла матрицы rows x cols с элементами типа T
+template <typename T>
+S21MatrixFileHeader S21MakeFileHeader(int rows, int cols);
+
+// Проверяет заголовок файла path длиной length байт: формат, тип
+// элементов, выравнивание (степень двойки не меньше 64 байт, ему кратны
+// шаг строки и смещение данных, данные не перекрывают заголовок) и то,
+// что все строки помещаются в файл. Бросает std::runtime_error
+template <typename T>
+void S21CheckFileHeader(const S21MatrixFileHeader& header, std::size_t length,
+                        const std::string& path);
+
+// Матрица, отображенная из файла в память (см. S21BasicMatrix::MapFile).
+// Владеет отображением и освобождает его в деструкторе; виды, полученные
+// из View, действительны, пока объект жив. S21BasicMatrix<T>(std::move(
+// mapped)) забирает отображение в обычную матрицу без копирования
+// элементов, S21BasicMatrix<T>(mapped.View()) — копирует их
+template <typename T>
+class S21BasicMappedMatrix {
+ public:
+  S21BasicMappedMatrix(const std::string& path, S21MapMode mode);
+  S21BasicMappedMatrix(S21BasicMappedMatrix&& other) noexcept;
+  S21BasicMappedMatrix& operator=(S21BasicMappedMatrix&& other) noexcept;
+  S21BasicMappedMatrix(const S21BasicMappedMatrix&) = delete;
+  S21BasicMappedMatrix& operator=(const S21BasicMappedMatrix&) = delete;
+  ~S21BasicMappedMatrix();
+
+  int GetRows() const;
+  int GetCols() const;
+  int GetStride() const;
+  S21MapMode GetMode() const;
+
+  // Указатель на элемент (0, 0); строка i начинается с data() + i * stride
+  const T* data() const;
+
+  const T& operator()(int i, int j) const;
+
+  // Вид только для чтения
+  S21BasicConstMatrixView<T> View() const;
+
+  // Изменяемый вид. Только для kCopyOnWrite, иначе бросает
+  // std::logic_error
+  S21BasicMatrixView<T> MutableView();
+
+ private:
+  friend class S21BasicMatrix<T>;
+
+  // Передает отображение матрице: делает страницы записываемыми и
+  // возвращает распределитель, который снимет отображение, когда ему
+  // вернут буфер. Объект становится пустым
+  S21Allocator* Release();
+
+  // Снимает отображение
+  void Unmap();
+
+  void* base_;
+  std::size_t length_;
+  S21MapMode mode_;
+  int rows_, cols_, stride_;
+  T* data_;
+};
+
+using S21MappedMatrix = S21BasicMappedMatrix<double>;
+
+// Потоковая запись матрицы построчно, без матрицы в памяти: заголовок
+// пишется в конструкторе, строки — по одной через WriteRow
+template <typename T>
+class S21BasicMatrixWriter {
+ public:
+  // Создает файл path для матрицы rows x cols. Бросает
+  // std::runtime_error, если файл нельзя создать
+  S21BasicMatrixWriter(const std::string& path, int rows, int cols);
+
+  // Закрывает файл, не проверяя число записанных строк
+  ~S21BasicMatrixWriter();
+
+  S21BasicMatrixWriter(const S21BasicMatrixWriter&) = delete;
+  S21BasicMatrixWriter& operator=(const S21BasicMatrixWriter&) = delete;
+
+  // Дописывает очередную строку из cols элементов
+  void WriteRow(const T* row);
+
+  // Число уже записанных строк
+  int GetRowsWritten() const;
+
+  // Завершает запись. Бросает std::runtime_error, если записаны не все
+  // строки или произошла ошибка вывода
+  void Close();
+
+ private:
+  std::ofstream out_;
+  int rows_, cols_, stride_;
+  int rows_written_;
+};
+
+using S21MatrixWriter = S21BasicMatrixWriter<double>;
+
+extern template class S21BasicMappedMatrix<float>;
+extern template class S21BasicMappedMatrix<double>;
+extern template class S21BasicMappedMatrix<long double>;
+extern template class S21BasicMappedMatrix<int>;
+extern template class S21BasicMappedMatrix<std::int64_t>;
+extern template class S21BasicMatrixWriter<float>;
+extern template class S21BasicMatrixWriter<double>;
+extern template class S21BasicMatrixWriter<long double>;
+extern template class S21BasicMatrixWriter<int>;
+extern template class S21BasicMatrixWriter<std::int64_t>;
+
+#endif  // S21_MATRIX_FILE_H
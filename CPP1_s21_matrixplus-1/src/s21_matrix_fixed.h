@@ -0,0 +1,510 @@
+#ifndef S21_MATRIX_FIXED_H
+#define S21_MATRIX_FIXED_H
+
+// Матрица фиксированного размера R x C. Элементы лежат прямо в объекте
+// (на стеке, без выделения памяти), размеры известны компилятору, поэтому
+// циклы полностью разворачиваются, а несовпадение размеров в сложении
+// или умножении — ошибка компиляции, а не исключение. Все операции
+// constexpr: матрицы-константы можно считать во время компиляции.
+//
+// Определитель и обратная матрица для порядков до 4 считаются по явным
+// формулам через присоединенную матрицу, для больших — исключением Гаусса
+// (для целых типов — методом Барейса, как в S21BasicMatrix).
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+
+template <int R, int C, typename T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "Matrix elements must be numbers");
+
+ public:
+  using value_type = T;
+  static constexpr int kRows = R;
+  static constexpr int kCols = C;
+
+  // Нулевая матрица
+  constexpr S21FixedMatrix() : data_{} {}
+
+  // Элементы по строкам. Недостающие равны нулю, лишние — ошибка
+  // компиляции: S21FixedMatrix<2, 2> m({1, 2, 3, 4})
+  constexpr explicit S21FixedMatrix(const T (&values)[R * C]) : data_{} {
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        data_[i][j] = values[i * C + j];
+      }
+    }
+  }
+
+  // Копия динамической матрицы. Ее размер известен только во время
+  // выполнения, поэтому несовпадение — std::invalid_argument
+  explicit S21FixedMatrix(const S21BasicMatrix<T>& other) : data_{} {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::invalid_argument(
+          "Matrix dimensions do not match the fixed matrix size.");
+    }
+    for (int i = 0; i < R; ++i) {
+      const T* src = other.row(i).data();
+      for (int j = 0; j < C; ++j) {
+        data_[i][j] = src[j];
+      }
+    }
+  }
+
+  // Динамическая матрица с теми же элементами
+  explicit operator S21BasicMatrix<T>() const {
+    S21BasicMatrix<T> result(R, C);
+    for (int i = 0; i < R; ++i) {
+      T* dst = result.row(i).data();
+      for (int j = 0; j < C; ++j) {
+        dst[j] = data_[i][j];
+      }
+    }
+    return result;
+  }
+
+  // Единичная матрица
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(R == C, "Identity matrix must be square");
+    S21FixedMatrix result;
+    for (int i = 0; i < R; ++i) {
+      result.data_[i][i] = 1;
+    }
+    return result;
+  }
+
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  // Доступ к элементу без проверки индексов
+  constexpr T& operator()(int i, int j) { return data_[i][j]; }
+  constexpr const T& operator()(int i, int j) const { return data_[i][j]; }
+
+  // Элементы по строкам без промежутков
+  constexpr T* data() { return &data_[0][0]; }
+  constexpr const T* data() const { return &data_[0][0]; }
+
+  // methods
+
+  // Проверяет матрицы на равенство с допуском S21MatrixTraits<T>
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    bool result = true;
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+      for (int j = 0; j < C; ++j) {
+        result = result && Abs(data_[i][j] - other.data_[i][j]) <= EPS;
+      }
+    }
+    return result;
+  }
+
+  // Прибавляет вторую матрицу к текущей
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+      for (int j = 0; j < C; ++j) {
+        data_[i][j] += other.data_[i][j];
+      }
+    }
+  }
+
+  // Вычитает из текущей матрицы другую
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+      for (int j = 0; j < C; ++j) {
+        data_[i][j] -= other.data_[i][j];
+      }
+    }
+  }
+
+  // Умножает текущую матрицу на число
+  constexpr void MulNumber(const T num) {
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+      for (int j = 0; j < C; ++j) {
+        data_[i][j] *= num;
+      }
+    }
+  }
+
+  // Умножает текущую матрицу на квадратную; размер не меняется
+  constexpr void MulMatrix(const S21FixedMatrix<C, C, T>& other) {
+    *this = *this * other;
+  }
+
+  // Транспонированная матрица C x R
+  constexpr S21FixedMatrix<C, R, T> Transpose() const {
+    S21FixedMatrix<C, R, T> result;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result(j, i) = data_[i][j];
+      }
+    }
+    return result;
+  }
+
+  // Вычисляет и возвращает определитель
+  constexpr T Determinant() const;
+
+  // Вычисляет матрицу алгебраических дополнений
+  constexpr S21FixedMatrix CalcComplements() const {
+    return Adjugate().Transpose();
+  }
+
+  // Вычисляет обратную матрицу. Бросает std::invalid_argument для
+  // вырожденной матрицы, а для целых типов — если определитель не 1 и не -1
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  // operators
+
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+
+  // Произведение определено, только если число столбцов равно числу
+  // строк второй матрицы; иначе перегрузка не подходит
+  template <int K>
+  constexpr S21FixedMatrix<R, K, T> operator*(
+      const S21FixedMatrix<C, K, T>& other) const {
+    S21FixedMatrix<R, K, T> result;
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+      for (int k = 0; k < C; ++k) {
+        const T a = data_[i][k];
+#pragma GCC unroll 16
+        for (int j = 0; j < K; ++j) {
+          result(i, j) += a * other(k, j);
+        }
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator*(const T num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+
+  friend constexpr S21FixedMatrix operator*(const T num,
+                                            const S21FixedMatrix& matrix) {
+    return matrix * num;
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C, T>& other) {
+    MulMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const T num) {
+    MulNumber(num);
+    return *this;
+  }
+
+ private:
+  template <int, int, typename>
+  friend class S21FixedMatrix;
+
+  static constexpr T EPS = S21MatrixTraits<T>::kEpsilon;
+
+  static constexpr T Abs(T x) { return x < 0 ? -x : x; }
+
+  // Матрица без строки row и столбца col
+  constexpr S21FixedMatrix<R - 1, C - 1, T> Minor(int row, int col) const {
+    S21FixedMatrix<R - 1, C - 1, T> result;
+    for (int i = 0, minor_i = 0; i < R; ++i) {
+      if (i == row) continue;
+      for (int j = 0, minor_j = 0; j < C; ++j) {
+        if (j == col) continue;
+        result(minor_i, minor_j) = data_[i][j];
+        ++minor_j;
+      }
+      ++minor_i;
+    }
+    return result;
+  }
+
+  // Присоединенная матрица adj(A) = C^T: явные формулы до порядка 4,
+  // для больших — через определители миноров
+  constexpr S21FixedMatrix Adjugate() const;
+
+  // Определитель исключением: Гаусс с выбором ведущего элемента или
+  // Барейс для целых типов
+  constexpr T EliminationDeterminant() const;
+
+  // Обратная матрица методом Гаусса-Жордана с выбором ведущего элемента
+  constexpr S21FixedMatrix GaussJordanInverse() const;
+
+  // Меняет местами строки a и b
+  constexpr void SwapRows(int a, int b) {
+    for (int j = 0; j < C; ++j) {
+      const T tmp = data_[a][j];
+      data_[a][j] = data_[b][j];
+      data_[b][j] = tmp;
+    }
+  }
+
+  T data_[R][C];
+};
+
+template <int R, int C, typename T>
+constexpr T S21FixedMatrix<R, C, T>::Determinant() const {
+  static_assert(R == C,
+                "Determinant can only be calculated for square matrices");
+  const auto& a = data_;
+  if constexpr (R == 1) {
+    return a[0][0];
+  } else if constexpr (R == 2) {
+    return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  } else if constexpr (R == 3) {
+    return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+           a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+           a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  } else if constexpr (R == 4) {
+    // Разложение Лапласа по первым двум строкам: шесть миноров 2x2
+    // верхней половины на дополнительные миноры нижней
+    const T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    const T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    const T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    const T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    const T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    const T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+    const T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+    const T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    const T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    const T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    const T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    const T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  } else {
+    return EliminationDeterminant();
+  }
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> S21FixedMatrix<R, C, T>::Adjugate() const {
+  static_assert(R == C, "Complements can only be calculated for square "
+                        "matrices");
+  const auto& a = data_;
+  S21FixedMatrix b;
+  if constexpr (R == 1) {
+    b(0, 0) = 1;
+  } else if constexpr (R == 2) {
+    b(0, 0) = a[1][1];
+    b(0, 1) = -a[0][1];
+    b(1, 0) = -a[1][0];
+    b(1, 1) = a[0][0];
+  } else if constexpr (R == 3) {
+    b(0, 0) = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+    b(0, 1) = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+    b(0, 2) = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+    b(1, 0) = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+    b(1, 1) = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+    b(1, 2) = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+    b(2, 0) = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+    b(2, 1) = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+    b(2, 2) = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  } else if constexpr (R == 4) {
+    // Те же миноры 2x2, что и в Determinant: каждое дополнение — сумма
+    // трех произведений
+    const T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    const T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    const T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    const T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    const T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    const T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+    const T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+    const T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    const T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    const T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    const T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    const T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    b(0, 0) = a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+    b(0, 1) = -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3;
+    b(0, 2) = a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+    b(0, 3) = -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3;
+    b(1, 0) = -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1;
+    b(1, 1) = a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+    b(1, 2) = -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1;
+    b(1, 3) = a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+    b(2, 0) = a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+    b(2, 1) = -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0;
+    b(2, 2) = a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+    b(2, 3) = -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0;
+    b(3, 0) = -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0;
+    b(3, 1) = a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+    b(3, 2) = -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0;
+    b(3, 3) = a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+  } else {
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        const T cofactor = Minor(i, j).Determinant();
+        b(j, i) = (i + j) % 2 == 0 ? cofactor : -cofactor;
+      }
+    }
+  }
+  return b;
+}
+
+template <int R, int C, typename T>
+constexpr T S21FixedMatrix<R, C, T>::EliminationDeterminant() const {
+  S21FixedMatrix work(*this);
+  T sign = 1;
+  if constexpr (std::is_integral_v<T>) {
+    // Барейс: после шага k элемент (i, j) — минор порядка k + 2,
+    // поэтому деление на предыдущий ведущий элемент нацело
+    T previous = 1;
+    for (int k = 0; k < R - 1; ++k) {
+      if (work(k, k) == 0) {
+        int pivot = k + 1;
+        while (pivot < R && work(pivot, k) == 0) {
+          ++pivot;
+        }
+        if (pivot == R) {
+          return 0;
+        }
+        work.SwapRows(k, pivot);
+        sign = -sign;
+      }
+      for (int i = k + 1; i < R; ++i) {
+        for (int j = k + 1; j < C; ++j) {
+          work(i, j) =
+              (work(i, j) * work(k, k) - work(i, k) * work(k, j)) / previous;
+        }
+      }
+      previous = work(k, k);
+    }
+    return sign * work(R - 1, C - 1);
+  } else {
+    T det = 1;
+    for (int k = 0; k < R; ++k) {
+      int pivot = k;
+      for (int i = k + 1; i < R; ++i) {
+        if (Abs(work(i, k)) > Abs(work(pivot, k))) {
+          pivot = i;
+        }
+      }
+      if (work(pivot, k) == 0) {
+        return 0;
+      }
+      if (pivot != k) {
+        work.SwapRows(k, pivot);
+        sign = -sign;
+      }
+      det *= work(k, k);
+      for (int i = k + 1; i < R; ++i) {
+        const T factor = work(i, k) / work(k, k);
+        for (int j = k + 1; j < C; ++j) {
+          work(i, j) -= factor * work(k, j);
+        }
+      }
+    }
+    return sign * det;
+  }
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T>
+S21FixedMatrix<R, C, T>::GaussJordanInverse() const {
+  S21FixedMatrix work(*this);
+  S21FixedMatrix result = Identity();
+  for (int k = 0; k < R; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < R; ++i) {
+      if (Abs(work(i, k)) > Abs(work(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (work(pivot, k) == 0) {
+      throw std::invalid_argument(
+          "Inverse matrix does not exist for singular matrices (determinant "
+          "is zero).");
+    }
+    work.SwapRows(k, pivot);
+    result.SwapRows(k, pivot);
+    const T diag = work(k, k);
+    for (int j = 0; j < C; ++j) {
+      work(k, j) /= diag;
+      result(k, j) /= diag;
+    }
+    for (int i = 0; i < R; ++i) {
+      const T factor = work(i, k);
+      if (i == k || factor == 0) continue;
+      for (int j = 0; j < C; ++j) {
+        work(i, j) -= factor * work(k, j);
+        result(i, j) -= factor * result(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> S21FixedMatrix<R, C, T>::InverseMatrix()
+    const {
+  static_assert(R == C,
+                "Inverse matrix can only be calculated for square matrices");
+  if constexpr (std::is_floating_point_v<T> && R > 4) {
+    return GaussJordanInverse();
+  } else {
+    // A^-1 = adj(A) / det(A); определитель — первая строка A на первый
+    // столбец adj(A)
+    S21FixedMatrix adjugate = Adjugate();
+    T det = 0;
+    for (int k = 0; k < R; ++k) {
+      det += data_[0][k] * adjugate(k, 0);
+    }
+    if (det == 0) {
+      throw std::invalid_argument(
+          "Inverse matrix does not exist for singular matrices (determinant "
+          "is zero).");
+    }
+    if constexpr (std::is_integral_v<T>) {
+      if (det != 1 && det != -1) {
+        throw std::invalid_argument(
+            "Inverse of an integer matrix exists only if the determinant is "
+            "1 or -1.");
+      }
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        adjugate(i, j) /= det;
+      }
+    }
+    return adjugate;
+  }
+}
+
+#endif  // S21_MATRIX_FIXED_H
@@ -0,0 +1,363 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+constexpr std::size_t kPackAlignment = 64;
+
+// Значения по умолчанию рассчитаны на L1 32 КБ, L2 от 512 КБ и L3 от 8 МБ:
+// микропанель B (kc * NR) занимает 16 КБ, блок A (mc * kc) — 256 КБ.
+// Настройки читаются потоками пула во время умножения, поэтому атомарны.
+// Размеры блоков хранятся по отдельности: умножение, идущее во время
+// S21SetGemmBlocking, может взять часть старых и часть новых размеров, но
+// каждый из них допустим
+std::atomic<int> g_block_mc{128};
+std::atomic<int> g_block_kc{256};
+std::atomic<int> g_block_nc{4096};
+std::atomic<long long> g_threshold{48LL * 48 * 48};
+
+// Растущий выровненный буфер для упакованных блоков. Хранится в
+// thread_local, поэтому повторные умножения не выделяют память заново
+template <typename T>
+class PackBuffer {
+ public:
+  PackBuffer() = default;
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  ~PackBuffer() { Release(); }
+
+  T* Reserve(std::size_t count) {
+    if (count > size_) {
+      Release();
+      data_ = static_cast<T*>(::operator new(
+          count * sizeof(T), std::align_val_t{kPackAlignment}));
+      size_ = count;
+    }
+    return data_;
+  }
+
+ private:
+  void Release() {
+    if (data_ != nullptr) {
+      ::operator delete(data_, std::align_val_t{kPackAlignment});
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Буферы упакованных блоков A и B текущего потока
+template <typename T>
+PackBuffer<T>& PackedA() {
+  thread_local PackBuffer<T> buffer;
+  return buffer;
+}
+
+template <typename T>
+PackBuffer<T>& PackedB() {
+  thread_local PackBuffer<T> buffer;
+  return buffer;
+}
+
+inline std::size_t Offset(int row, int ld) {
+  return static_cast<std::size_t>(row) * ld;
+}
+
+// Указатель на элемент (row, col) операнда op(X), хранящегося с шагом ld
+template <typename T>
+const T* At(const T* x, bool trans, int row, int col, int ld) {
+  return trans ? x + Offset(col, ld) + row : x + Offset(row, ld) + col;
+}
+
+// Упаковывает блок op(A) (mc x kc) в микропанели по mr строк: внутри
+// панели элементы идут столбец за столбцом, недостающие строки
+// дополняются нулями. Столбец op(A)^T лежит в строке A подряд
+template <typename T>
+void PackA(int mc, int kc, const T* a, int lda, bool trans, int mr,
+           T* packed) {
+  for (int i = 0; i < mc; i += mr) {
+    const int rows = std::min(mr, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      const T* src = At(a, trans, i, p, lda);
+      const std::size_t step = trans ? 1 : lda;
+      for (int r = 0; r < mr; ++r) {
+        *packed++ = r < rows ? src[r * step] : T(0);
+      }
+    }
+  }
+}
+
+// Упаковывает блок op(B) (kc x nc) в микропанели по nr столбцов: внутри
+// панели элементы идут строка за строкой, недостающие столбцы
+// дополняются нулями. Для op(B) = B^T столбец панели читается из строки
+// B подряд
+template <typename T>
+void PackB(int kc, int nc, const T* b, int ldb, bool trans, int nr,
+           T* packed) {
+  for (int j = 0; j < nc; j += nr) {
+    const int cols = std::min(nr, nc - j);
+    if (trans) {
+      for (int c = 0; c < nr; ++c) {
+        const T* src = b + Offset(j + c, ldb);
+        for (int p = 0; p < kc; ++p) {
+          packed[static_cast<std::size_t>(p) * nr + c] =
+              c < cols ? src[p] : T(0);
+        }
+      }
+      packed += static_cast<std::size_t>(kc) * nr;
+      continue;
+    }
+    for (int p = 0; p < kc; ++p) {
+      const T* src = b + Offset(p, ldb) + j;
+      for (int c = 0; c < nr; ++c) {
+        *packed++ = c < cols ? src[c] : T(0);
+      }
+    }
+  }
+}
+
+template <typename T>
+void ClearOutput(int m, int n, T* c, int ldc) {
+  for (int i = 0; i < m; ++i) {
+    std::fill_n(c + Offset(i, ldc), n, T(0));
+  }
+}
+
+// C += op(A) * op(B) в текущем потоке
+template <typename T>
+void BlockedSerial(bool trans_a, bool trans_b, int m, int n, int k,
+                   const T* a, int lda, const T* b, int ldb, T* c, int ldc) {
+  // Микроядро выбранного набора инструкций (см. s21_matrix_kernels.h)
+  const S21KernelTable<T>& kernels = S21GetKernels<T>();
+  const int mr = kernels.gemm_mr;
+  const int nr = kernels.gemm_nr;
+
+  // Размеры блоков округляем до кратных регистровому блоку
+  const S21GemmBlocking blocking = S21GetGemmBlocking();
+  const int mc_max = (std::min(blocking.mc, m) + mr - 1) / mr * mr;
+  const int nc_max = (std::min(blocking.nc, n) + nr - 1) / nr * nr;
+  const int kc_max = std::min(blocking.kc, k);
+  T* packed_a =
+      PackedA<T>().Reserve(static_cast<std::size_t>(mc_max) * kc_max);
+  T* packed_b =
+      PackedB<T>().Reserve(static_cast<std::size_t>(nc_max) * kc_max);
+
+  // Цикл 5: полосы столбцов B и C шириной nc (уровень L3)
+  for (int jc = 0; jc < n; jc += nc_max) {
+    const int nc = std::min(nc_max, n - jc);
+    // Цикл 4: слои глубины kc; упакованный блок B используется всеми
+    // строками A
+    for (int pc = 0; pc < k; pc += kc_max) {
+      const int kc = std::min(kc_max, k - pc);
+      PackB(kc, nc, At(b, trans_b, pc, jc, ldb), ldb, trans_b, nr, packed_b);
+      // Цикл 3: блоки строк A высотой mc (уровень L2)
+      for (int ic = 0; ic < m; ic += mc_max) {
+        const int mc = std::min(mc_max, m - ic);
+        PackA(mc, kc, At(a, trans_a, ic, pc, lda), lda, trans_a, mr,
+              packed_a);
+        // Циклы 2 и 1: микропанели B (уровень L1) и A (регистры)
+        for (int jr = 0; jr < nc; jr += nr) {
+          const T* panel_b = packed_b + static_cast<std::size_t>(jr) * kc;
+          for (int ir = 0; ir < mc; ir += mr) {
+            kernels.gemm_micro(kc, packed_a + static_cast<std::size_t>(ir) * kc,
+                               panel_b, c + Offset(ic + ir, ldc) + jc + jr,
+                               ldc, std::min(mr, mc - ir),
+                               std::min(nr, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// C = op(A) * op(B) (или C += ... при accumulate) простым циклом i-k-j
+template <typename T>
+void Naive(bool trans_a, bool trans_b, int m, int n, int k, const T* a,
+           int lda, const T* b, int ldb, T* c, int ldc, bool accumulate) {
+  if (!accumulate) {
+    ClearOutput(m, n, c, ldc);
+  }
+  // Порядок i-k-j: внутренний цикл идет по строкам B и C подряд
+  for (int i = 0; i < m; ++i) {
+    T* dst = c + Offset(i, ldc);
+    for (int p = 0; p < k; ++p) {
+      const T value = *At(a, trans_a, i, p, lda);
+      if (trans_b) {
+        // Строка op(B) — столбец B
+        for (int j = 0; j < n; ++j) {
+          dst[j] += value * b[Offset(j, ldb) + p];
+        }
+      } else {
+        const T* rhs = b + Offset(p, ldb);
+        for (int j = 0; j < n; ++j) {
+          dst[j] += value * rhs[j];
+        }
+      }
+    }
+  }
+}
+
+// C = op(A) * op(B) (или C += ... при accumulate) блочным алгоритмом
+template <typename T>
+void Blocked(bool trans_a, bool trans_b, int m, int n, int k, const T* a,
+             int lda, const T* b, int ldb, T* c, int ldc, bool accumulate) {
+  if (!accumulate) {
+    ClearOutput(m, n, c, ldc);
+  }
+  if (m <= 0 || n <= 0 || k <= 0) {
+    return;
+  }
+
+  const long long work = static_cast<long long>(m) * n * k;
+  const int threads = S21GetThreadCount();
+  if (threads == 1 || work < S21GetParallelCutoff()) {
+    BlockedSerial(trans_a, trans_b, m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  // Делим C на сетку плиток row_parts x col_parts, кратных регистровому
+  // блоку. Плитки не пересекаются, поэтому потоки пишут в C без
+  // синхронизации; каждый упаковывает свои блоки в thread_local буферы
+  const S21KernelTable<T>& kernels = S21GetKernels<T>();
+  const int mr = kernels.gemm_mr;
+  const int nr = kernels.gemm_nr;
+  const int row_panels = (m + mr - 1) / mr;
+  const int col_panels = (n + nr - 1) / nr;
+  const int row_parts = std::min(threads, row_panels);
+  const int col_parts = std::min(std::max(1, threads / row_parts), col_panels);
+  const int tile_m = (row_panels + row_parts - 1) / row_parts * mr;
+  const int tile_n = (col_panels + col_parts - 1) / col_parts * nr;
+
+  S21ParallelFor(row_parts * col_parts, work, [&](int begin, int end) {
+    for (int tile = begin; tile < end; ++tile) {
+      const int i0 = tile / col_parts * tile_m;
+      const int j0 = tile % col_parts * tile_n;
+      if (i0 < m && j0 < n) {
+        BlockedSerial(trans_a, trans_b, std::min(tile_m, m - i0),
+                      std::min(tile_n, n - j0), k, At(a, trans_a, i0, 0, lda),
+                      lda, At(b, trans_b, 0, j0, ldb), ldb,
+                      c + Offset(i0, ldc) + j0, ldc);
+      }
+    }
+  });
+}
+
+}  // namespace
+
+S21GemmBlocking S21GetGemmBlocking() {
+  return {g_block_mc, g_block_kc, g_block_nc};
+}
+
+void S21SetGemmBlocking(const S21GemmBlocking& blocking) {
+  if (blocking.mc <= 0 || blocking.kc <= 0 || blocking.nc <= 0) {
+    throw std::invalid_argument("GEMM block sizes must be greater than zero");
+  }
+  g_block_mc = blocking.mc;
+  g_block_kc = blocking.kc;
+  g_block_nc = blocking.nc;
+}
+
+long long S21GetGemmThreshold() { return g_threshold; }
+
+void S21SetGemmThreshold(long long threshold) { g_threshold = threshold; }
+
+template <typename T>
+void S21GemmNaive(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, bool accumulate) {
+  Naive(false, false, m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+template <typename T>
+void S21GemmBlocked(int m, int n, int k, const T* a, int lda, const T* b,
+                    int ldb, T* c, int ldc, bool accumulate) {
+  Blocked(false, false, m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+template <typename T>
+void S21Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+             T* c, int ldc, bool accumulate, S21MulAlgorithm algorithm) {
+  if constexpr (kS21HasKernels<T>) {
+    if (algorithm == S21MulAlgorithm::kAuto) {
+      algorithm = std::min({m, n, k}) >= S21GetStrassenThreshold()
+                      ? S21MulAlgorithm::kStrassen
+                      : S21MulAlgorithm::kClassic;
+    }
+    if (algorithm == S21MulAlgorithm::kStrassen && !accumulate) {
+      S21GemmStrassen(m, n, k, a, lda, b, ldb, c, ldc);
+      return;
+    }
+  }
+  S21Gemm(S21Transpose::kNo, S21Transpose::kNo, m, n, k, a, lda, b, ldb, c,
+          ldc, accumulate);
+}
+
+template <typename T>
+void S21Gemm(S21Transpose trans_a, S21Transpose trans_b, int m, int n, int k,
+             const T* a, int lda, const T* b, int ldb, T* c, int ldc,
+             bool accumulate) {
+  const bool ta = trans_a == S21Transpose::kYes;
+  const bool tb = trans_b == S21Transpose::kYes;
+  if constexpr (kS21HasKernels<T>) {
+    if (static_cast<long long>(m) * n * k >= g_threshold) {
+      Blocked(ta, tb, m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+      return;
+    }
+  }
+  // Для типов без векторных ядер есть только простой цикл
+  Naive(ta, tb, m, n, k, a, lda, b, ldb, c, ldc, accumulate);
+}
+
+template void S21GemmNaive(int, int, int, const float*, int, const float*, int,
+                           float*, int, bool);
+template void S21GemmNaive(int, int, int, const double*, int, const double*,
+                           int, double*, int, bool);
+template void S21GemmNaive(int, int, int, const long double*, int,
+                           const long double*, int, long double*, int, bool);
+template void S21GemmNaive(int, int, int, const int*, int, const int*, int,
+                           int*, int, bool);
+template void S21GemmNaive(int, int, int, const std::int64_t*, int,
+                           const std::int64_t*, int, std::int64_t*, int, bool);
+
+template void S21GemmBlocked(int, int, int, const float*, int, const float*,
+                             int, float*, int, bool);
+template void S21GemmBlocked(int, int, int, const double*, int, const double*,
+                             int, double*, int, bool);
+
+template void S21Gemm(int, int, int, const float*, int, const float*, int,
+                      float*, int, bool, S21MulAlgorithm);
+template void S21Gemm(int, int, int, const double*, int, const double*, int,
+                      double*, int, bool, S21MulAlgorithm);
+template void S21Gemm(int, int, int, const long double*, int,
+                      const long double*, int, long double*, int, bool,
+                      S21MulAlgorithm);
+template void S21Gemm(int, int, int, const int*, int, const int*, int, int*,
+                      int, bool, S21MulAlgorithm);
+template void S21Gemm(int, int, int, const std::int64_t*, int,
+                      const std::int64_t*, int, std::int64_t*, int, bool,
+                      S21MulAlgorithm);
+
+template void S21Gemm(S21Transpose, S21Transpose, int, int, int, const float*,
+                      int, const float*, int, float*, int, bool);
+template void S21Gemm(S21Transpose, S21Transpose, int, int, int,
+                      const double*, int, const double*, int, double*, int,
+                      bool);
+template void S21Gemm(S21Transpose, S21Transpose, int, int, int,
+                      const long double*, int, const long double*, int,
+                      long double*, int, bool);
+template void S21Gemm(S21Transpose, S21Transpose, int, int, int, const int*,
+                      int, const int*, int, int*, int, bool);
+template void S21Gemm(S21Transpose, S21Transpose, int, int, int,
+                      const std::int64_t*, int, const std::int64_t*, int,
+                      std::int64_t*, int, bool);
@@ -0,0 +1,110 @@
+#ifndef S21_MATRIX_GEMM_H
+#define S21_MATRIX_GEMM_H
+
+#include <cstddef>
+
+// Движок умножения матриц C = A * B для плотных матриц в построчном
+// хранении. Все матрицы задаются указателем на первый элемент и шагом
+// строки (ld) в элементах, как в хранилище S21BasicMatrix.
+//
+// Функции умножения — шаблоны по типу элементов T. Блочный алгоритм и
+// Штрассен собраны для float и double, у которых есть векторные ядра;
+// простой цикл и S21Gemm — также для long double, int и std::int64_t.
+
+// Размеры блоков блочного умножения
+struct S21GemmBlocking {
+  int mc;  // Строк A в упакованном блоке (блок A живет в L2)
+  int kc;  // Глубина блока (микропанель B живет в L1)
+  int nc;  // Столбцов B в упакованном блоке (блок B живет в L3)
+};
+
+// Текущие размеры блоков
+S21GemmBlocking S21GetGemmBlocking();
+
+// Задает размеры блоков; значения должны быть положительными. Как и
+// остальные настройки умножения, безопасно вызывается во время умножений
+// в других потоках; уже идущее умножение может взять часть старых
+// размеров
+void S21SetGemmBlocking(const S21GemmBlocking& blocking);
+
+// Минимальное число умножений m * n * k, с которого включается блочный
+// алгоритм; меньшие произведения считаются простым циклом
+long long S21GetGemmThreshold();
+void S21SetGemmThreshold(long long threshold);
+
+// C = A * B (или C += A * B при accumulate) простым циклом i-k-j
+template <typename T>
+void S21GemmNaive(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, bool accumulate = false);
+
+// C = A * B (или C += A * B при accumulate) блочным алгоритмом с упаковкой
+// операндов и микроядром с регистровой блокировкой
+template <typename T>
+void S21GemmBlocked(int m, int n, int k, const T* a, int lda, const T* b,
+                    int ldb, T* c, int ldc, bool accumulate = false);
+
+// Алгоритм умножения
+enum class S21MulAlgorithm {
+  kAuto,      // Выбор по размеру задачи
+  kClassic,   // Простой или блочный алгоритм, O(n^3)
+  kStrassen,  // Штрассен-Виноград, O(n^2.81)
+};
+
+// Выбирает алгоритм по размеру задачи: простой цикл, блочный алгоритм или,
+// если все размеры не меньше S21GetStrassenThreshold() и accumulate не
+// задан, Штрассен-Виноград. Явный algorithm отменяет автоматический выбор;
+// при accumulate всегда используется классический алгоритм. Для типов без
+// векторных ядер всегда используется простой цикл
+template <typename T>
+void S21Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+             T* c, int ldc, bool accumulate = false,
+             S21MulAlgorithm algorithm = S21MulAlgorithm::kAuto);
+
+// Операнд умножения: сама матрица или транспонированная. op(A) = A^T
+// размера m x k хранится как A — матрица k x m с шагом строки lda
+enum class S21Transpose { kNo, kYes };
+
+// C = op(A) * op(B) (или C += op(A) * op(B) при accumulate).
+// Транспонирование учитывается при упаковке блоков, поэтому
+// транспонированная матрица не создается. С транспонированными операндами
+// Штрассен не используется
+template <typename T>
+void S21Gemm(S21Transpose trans_a, S21Transpose trans_b, int m, int n, int k,
+             const T* a, int lda, const T* b, int ldb, T* c, int ldc,
+             bool accumulate = false);
+
+// Умножение Штрассена-Винограда: 7 умножений половинного размера и 15
+// сложений на уровень рекурсии. Нечетные размеры обрабатываются
+// отщеплением последней строки или столбца. Рекурсия останавливается,
+// когда наименьший из размеров m, n, k не больше точки перехода; такие
+// блоки считает S21GemmBlocked.
+//
+// Погрешность (Higham, "Accuracy and Stability of Numerical Algorithms",
+// гл. 23) для n x n матриц, размера перехода n0 и единицы округления
+// u = DBL_EPSILON / 2:
+//   max|C - fl(C)| <= ((n / n0)^log2(18) * (n0^2 + 6 * n0) - 6 * n) * u
+//                     * max|A| * max|B|
+// Оценка растет быстрее, чем n * u * max|A| * max|B| у классического
+// алгоритма, а ошибка распределяется по элементам неравномерно, поэтому
+// Штрассен подходит для хорошо масштабированных данных
+
+// Точка перехода к блочному алгоритму (не меньше 16)
+int S21GetStrassenCrossover();
+void S21SetStrassenCrossover(int crossover);
+
+// Наименьший размер, с которого kAuto выбирает Штрассена
+int S21GetStrassenThreshold();
+void S21SetStrassenThreshold(int threshold);
+
+// Размер рабочей памяти Штрассена в элементах для всех уровней рекурсии
+std::size_t S21StrassenWorkspaceSize(int m, int n, int k);
+
+// C = A * B алгоритмом Штрассена-Винограда. workspace — буфер из
+// S21StrassenWorkspaceSize(m, n, k) элементов (лучше выровненный на 64
+// байта); при nullptr он выделяется один раз на вызов. Уровни рекурсии
+// делят этот буфер и память не выделяют
+template <typename T>
+void S21GemmStrassen(int m, int n, int k, const T* a, int lda, const T* b,
+                     int ldb, T* c, int ldc, T* workspace = nullptr);
+
+#endif  // S21_MATRIX_GEMM_H
@@ -0,0 +1,138 @@
+#include "s21_matrix_kernels.h"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_matrix_kernels_impl.h"
+
+namespace {
+
+// Скалярная реализация: переносимый код без intrinsics, «регистр» — один
+// элемент. Используется на процессорах без SIMD и как эталон в тестах
+template <typename T>
+struct ScalarOps {
+  using Scalar = T;
+  using Reg = T;
+  static constexpr int kWidth = 1;
+
+  static Reg Zero() { return 0; }
+  static Reg Set1(T x) { return x; }
+  static Reg Load(const T* p) { return *p; }
+  static void Store(T* p, Reg v) { *p = v; }
+  static Reg Add(Reg a, Reg b) { return a + b; }
+  static Reg Sub(Reg a, Reg b) { return a - b; }
+  static Reg Mul(Reg a, Reg b) { return a * b; }
+  static Reg Div(Reg a, Reg b) { return a / b; }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return a * b + c; }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    return std::abs(a - b) > eps;
+  }
+};
+
+constexpr S21KernelTable<double> kScalarKernels =
+    s21_kernels_impl::MakeKernels<ScalarOps<double>, 4, 4>(S21Isa::kScalar,
+                                                           "scalar");
+constexpr S21KernelTable<float> kScalarKernelsF =
+    s21_kernels_impl::MakeKernels<ScalarOps<float>, 4, 4>(S21Isa::kScalar,
+                                                          "scalar");
+
+// Проверяет через CPUID, что процессор и ОС поддерживают набор инструкций
+bool CpuSupports(S21Isa isa) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  switch (isa) {
+    case S21Isa::kScalar:
+      return true;
+    case S21Isa::kSse2:
+      return __builtin_cpu_supports("sse2");
+    case S21Isa::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case S21Isa::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  return isa == S21Isa::kScalar;
+#endif
+}
+
+s21_kernels_impl::IsaTables CompiledTables(S21Isa isa) {
+  switch (isa) {
+    case S21Isa::kScalar:
+      return s21_kernels_impl::ScalarTables();
+    case S21Isa::kSse2:
+      return s21_kernels_impl::Sse2Tables();
+    case S21Isa::kAvx2:
+      return s21_kernels_impl::Avx2Tables();
+    case S21Isa::kAvx512:
+      return s21_kernels_impl::Avx512Tables();
+  }
+  return {nullptr, nullptr};
+}
+
+template <typename T>
+const S21KernelTable<T>* CompiledTable(S21Isa isa) {
+  if constexpr (std::is_same_v<T, float>) {
+    return CompiledTables(isa).f32;
+  } else {
+    return CompiledTables(isa).f64;
+  }
+}
+
+// Активная таблица для типа T; выбирается при первом обращении.
+// Таблицы float и double всегда относятся к одному набору инструкций
+template <typename T>
+std::atomic<const S21KernelTable<T>*>& ActiveTable() {
+  static std::atomic<const S21KernelTable<T>*> active{
+      S21GetKernels<T>(S21DetectIsa())};
+  return active;
+}
+
+}  // namespace
+
+s21_kernels_impl::IsaTables s21_kernels_impl::ScalarTables() {
+  return {&kScalarKernels, &kScalarKernelsF};
+}
+
+bool S21IsaSupported(S21Isa isa) {
+  return CompiledTables(isa).f64 != nullptr && CpuSupports(isa);
+}
+
+S21Isa S21DetectIsa() {
+  const S21Isa order[] = {S21Isa::kAvx512, S21Isa::kAvx2, S21Isa::kSse2};
+  for (S21Isa isa : order) {
+    if (S21IsaSupported(isa)) {
+      return isa;
+    }
+  }
+  return S21Isa::kScalar;
+}
+
+S21Isa S21GetActiveIsa() { return S21GetKernels().isa; }
+
+void S21SetActiveIsa(S21Isa isa) {
+  if (!S21IsaSupported(isa)) {
+    throw std::invalid_argument(
+        "Instruction set is not supported by this build or processor");
+  }
+  ActiveTable<double>().store(CompiledTable<double>(isa),
+                              std::memory_order_release);
+  ActiveTable<float>().store(CompiledTable<float>(isa),
+                             std::memory_order_release);
+}
+
+template <typename T>
+const S21KernelTable<T>& S21GetKernels() {
+  return *ActiveTable<T>().load(std::memory_order_acquire);
+}
+
+template <typename T>
+const S21KernelTable<T>* S21GetKernels(S21Isa isa) {
+  return S21IsaSupported(isa) ? CompiledTable<T>(isa) : nullptr;
+}
+
+template const S21KernelTable<float>& S21GetKernels<float>();
+template const S21KernelTable<double>& S21GetKernels<double>();
+template const S21KernelTable<float>* S21GetKernels<float>(S21Isa isa);
+template const S21KernelTable<double>* S21GetKernels<double>(S21Isa isa);
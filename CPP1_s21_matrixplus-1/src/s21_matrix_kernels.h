@@ -0,0 +1,167 @@
+#ifndef S21_MATRIX_KERNELS_H
+#define S21_MATRIX_KERNELS_H
+
+// Слой вычислительных ядер с выбором набора инструкций во время работы.
+// При первом обращении процессор опрашивается через CPUID и выбирается
+// лучшая из собранных реализаций: AVX-512, AVX2+FMA, SSE2 или скалярная.
+// Один и тот же бинарный файл работает на любом x86-64 процессоре.
+
+#include <cstddef>
+#include <type_traits>
+
+// Наборы инструкций в порядке возрастания приоритета
+enum class S21Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Таблица ядер для одного набора инструкций и типа элементов T (float
+// или double). Все ядра работают с непрерывными участками памяти
+// (например, строками S21BasicMatrix)
+template <typename T>
+struct S21KernelTable {
+  S21Isa isa;
+  const char* name;
+
+  // dst[i] += src[i]
+  void (*add)(int n, T* dst, const T* src);
+  // dst[i] -= src[i]
+  void (*sub)(int n, T* dst, const T* src);
+  // dst[i] *= num
+  void (*scale)(int n, T* dst, T num);
+  // dst[i] += alpha * src[i]
+  void (*axpy)(int n, T alpha, const T* src, T* dst);
+  // true, если |a[i] - b[i]| <= eps для всех i
+  bool (*equal)(int n, const T* a, const T* b, T eps);
+  // Сумма a[i] * b[i]
+  T (*dot)(int n, const T* a, const T* b);
+
+  // Размер регистрового блока микроядра умножения
+  int gemm_mr;
+  int gemm_nr;
+  // C(mr x nr) += A * B для упакованных микропанелей глубины kc
+  // (раскладку упаковки см. в s21_matrix_gemm.cpp)
+  void (*gemm_micro)(int kc, const T* a, const T* b, T* c, int ldc, int mr,
+                     int nr);
+
+  // Пакетные ядра для count матриц в виде структуры массивов: элемент
+  // (i, j) матрицы l лежит в data[(i * cols + j) * stride + l]
+  // (см. s21_matrix_batch.h). Векторные регистры охватывают соседние
+  // матрицы пакета
+
+  // C = A * B для матриц m x k и k x n; C не пересекается с A и B
+  void (*batch_mul)(int count, int m, int n, int k, const T* a, const T* b,
+                    T* c, std::ptrdiff_t stride);
+  // det[l] — определитель матрицы l порядка n <= 4
+  void (*batch_det)(int count, int n, const T* a, T* det,
+                    std::ptrdiff_t stride);
+  // inverse = A^-1 по явным формулам для n <= 4; det[l] — определитель
+  // (для вырожденных матриц inverse не определена)
+  void (*batch_inverse)(int count, int n, const T* a, T* inverse, T* det,
+                        std::ptrdiff_t stride);
+};
+
+using S21Kernels = S21KernelTable<double>;
+
+// Есть ли для типа векторные ядра. Остальные типы (целые, long double)
+// обрабатываются обычными циклами
+template <typename T>
+inline constexpr bool kS21HasKernels =
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Собрана ли реализация и поддерживает ли ее текущий процессор
+bool S21IsaSupported(S21Isa isa);
+
+// Лучший набор инструкций, доступный на текущем процессоре
+S21Isa S21DetectIsa();
+
+// Набор инструкций, ядра которого используются сейчас
+S21Isa S21GetActiveIsa();
+
+// Принудительно выбирает набор инструкций (для тестов и бенчмарков).
+// Бросает std::invalid_argument, если набор не поддерживается
+void S21SetActiveIsa(S21Isa isa);
+
+// Активная таблица ядер для типа T (float или double)
+template <typename T = double>
+const S21KernelTable<T>& S21GetKernels();
+
+// Таблица ядер конкретного набора инструкций или nullptr, если он
+// не поддерживается
+template <typename T = double>
+const S21KernelTable<T>* S21GetKernels(S21Isa isa);
+
+// Поэлементные операции для любого типа: float и double идут через
+// активную таблицу ядер, остальные типы — через простые циклы
+
+template <typename T>
+void S21KernelAdd(int n, T* dst, const T* src) {
+  if constexpr (kS21HasKernels<T>) {
+    S21GetKernels<T>().add(n, dst, src);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      dst[i] += src[i];
+    }
+  }
+}
+
+template <typename T>
+void S21KernelSub(int n, T* dst, const T* src) {
+  if constexpr (kS21HasKernels<T>) {
+    S21GetKernels<T>().sub(n, dst, src);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      dst[i] -= src[i];
+    }
+  }
+}
+
+template <typename T>
+void S21KernelScale(int n, T* dst, T num) {
+  if constexpr (kS21HasKernels<T>) {
+    S21GetKernels<T>().scale(n, dst, num);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      dst[i] *= num;
+    }
+  }
+}
+
+template <typename T>
+void S21KernelAxpy(int n, T alpha, const T* src, T* dst) {
+  if constexpr (kS21HasKernels<T>) {
+    S21GetKernels<T>().axpy(n, alpha, src, dst);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      dst[i] += alpha * src[i];
+    }
+  }
+}
+
+template <typename T>
+T S21KernelDot(int n, const T* a, const T* b) {
+  if constexpr (kS21HasKernels<T>) {
+    return S21GetKernels<T>().dot(n, a, b);
+  } else {
+    T sum = 0;
+    for (int i = 0; i < n; ++i) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+}
+
+template <typename T>
+bool S21KernelEqual(int n, const T* a, const T* b, T eps) {
+  if constexpr (kS21HasKernels<T>) {
+    return S21GetKernels<T>().equal(n, a, b, eps);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      // Разность большего и меньшего неотрицательна для любого типа
+      const T diff = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+      if (diff > eps) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+#endif  // S21_MATRIX_KERNELS_H
@@ -0,0 +1,73 @@
+// Ядра AVX2 + FMA. Единица трансляции собирается с -mavx2 -mfma
+// (см. Makefile); код из нее вызывается только после проверки CPUID
+
+#include "s21_matrix_kernels_impl.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2 {
+  using Scalar = double;
+  using Reg = __m256d;
+  static constexpr int kWidth = 4;
+
+  static Reg Zero() { return _mm256_setzero_pd(); }
+  static Reg Set1(double x) { return _mm256_set1_pd(x); }
+  static Reg Load(const double* p) { return _mm256_loadu_pd(p); }
+  static void Store(double* p, Reg v) { _mm256_storeu_pd(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return _mm256_fmadd_pd(a, b, c); }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff =
+        _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(a, b));
+    return _mm256_movemask_pd(_mm256_cmp_pd(diff, eps, _CMP_GT_OQ)) != 0;
+  }
+};
+
+struct Avx2Float {
+  using Scalar = float;
+  using Reg = __m256;
+  static constexpr int kWidth = 8;
+
+  static Reg Zero() { return _mm256_setzero_ps(); }
+  static Reg Set1(float x) { return _mm256_set1_ps(x); }
+  static Reg Load(const float* p) { return _mm256_loadu_ps(p); }
+  static void Store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff =
+        _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(a, b));
+    return _mm256_movemask_ps(_mm256_cmp_ps(diff, eps, _CMP_GT_OQ)) != 0;
+  }
+};
+
+// 6 x 8 (float: 6 x 16): 12 аккумуляторов, 2 регистра строки B и 1 для
+// элемента A
+constexpr S21KernelTable<double> kAvx2Kernels =
+    s21_kernels_impl::MakeKernels<Avx2, 6, 2>(S21Isa::kAvx2, "avx2");
+constexpr S21KernelTable<float> kAvx2KernelsF =
+    s21_kernels_impl::MakeKernels<Avx2Float, 6, 2>(S21Isa::kAvx2, "avx2");
+
+}  // namespace
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Avx2Tables() {
+  return {&kAvx2Kernels, &kAvx2KernelsF};
+}
+
+#else
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Avx2Tables() {
+  return {nullptr, nullptr};
+}
+
+#endif
@@ -0,0 +1,71 @@
+// Ядра AVX-512F. Единица трансляции собирается с -mavx512f
+// (см. Makefile); код из нее вызывается только после проверки CPUID
+
+#include "s21_matrix_kernels_impl.h"
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512 {
+  using Scalar = double;
+  using Reg = __m512d;
+  static constexpr int kWidth = 8;
+
+  static Reg Zero() { return _mm512_setzero_pd(); }
+  static Reg Set1(double x) { return _mm512_set1_pd(x); }
+  static Reg Load(const double* p) { return _mm512_loadu_pd(p); }
+  static void Store(double* p, Reg v) { _mm512_storeu_pd(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm512_div_pd(a, b); }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return _mm512_fmadd_pd(a, b, c); }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff = _mm512_abs_pd(_mm512_sub_pd(a, b));
+    return _mm512_cmp_pd_mask(diff, eps, _CMP_GT_OQ) != 0;
+  }
+};
+
+struct Avx512Float {
+  using Scalar = float;
+  using Reg = __m512;
+  static constexpr int kWidth = 16;
+
+  static Reg Zero() { return _mm512_setzero_ps(); }
+  static Reg Set1(float x) { return _mm512_set1_ps(x); }
+  static Reg Load(const float* p) { return _mm512_loadu_ps(p); }
+  static void Store(float* p, Reg v) { _mm512_storeu_ps(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm512_div_ps(a, b); }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return _mm512_fmadd_ps(a, b, c); }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff = _mm512_abs_ps(_mm512_sub_ps(a, b));
+    return _mm512_cmp_ps_mask(diff, eps, _CMP_GT_OQ) != 0;
+  }
+};
+
+// 12 x 16 (float: 12 x 32): 24 аккумулятора из 32 регистров zmm
+constexpr S21KernelTable<double> kAvx512Kernels =
+    s21_kernels_impl::MakeKernels<Avx512, 12, 2>(S21Isa::kAvx512, "avx512");
+constexpr S21KernelTable<float> kAvx512KernelsF =
+    s21_kernels_impl::MakeKernels<Avx512Float, 12, 2>(S21Isa::kAvx512,
+                                                      "avx512");
+
+}  // namespace
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Avx512Tables() {
+  return {&kAvx512Kernels, &kAvx512KernelsF};
+}
+
+#else
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Avx512Tables() {
+  return {nullptr, nullptr};
+}
+
+#endif
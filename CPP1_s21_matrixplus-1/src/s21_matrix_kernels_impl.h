@@ -0,0 +1,409 @@
+#ifndef S21_MATRIX_KERNELS_IMPL_H
+#define S21_MATRIX_KERNELS_IMPL_H
+
+// Общие шаблоны ядер. Файл подключается каждой единицей трансляции
+// s21_matrix_kernels_*.cpp, которая собирается со своими флагами
+// процессора и подставляет свой класс векторных операций V:
+//
+//   Scalar                   — тип элементов (float или double)
+//   Reg                      — тип векторного регистра
+//   kWidth                   — число элементов в регистре
+//   Zero(), Set1(x)          — заполнение регистра
+//   Load(p), Store(p, v)     — невыровненные загрузка и сохранение
+//   Add, Sub, Mul, Div       — поэлементные операции
+//   Fmadd(a, b, c)           — a * b + c
+//   AnyAbsGreater(a, b, eps) — есть ли |a[i] - b[i]| > eps
+//
+// Типы V объявляются во внутреннем пространстве имен каждой единицы,
+// поэтому экземпляры шаблонов не смешиваются при компоновке.
+
+#include <cmath>
+#include <cstddef>
+
+#include "s21_matrix_kernels.h"
+
+namespace s21_kernels_impl {
+
+// Таблицы ядер одного набора инструкций для double и float
+struct IsaTables {
+  const S21KernelTable<double>* f64;
+  const S21KernelTable<float>* f32;
+};
+
+// Таблицы отдельных наборов инструкций. Указатели равны nullptr, если
+// единица трансляции собрана без поддержки набора
+IsaTables ScalarTables();
+IsaTables Sse2Tables();
+IsaTables Avx2Tables();
+IsaTables Avx512Tables();
+
+template <class V, typename T = typename V::Scalar>
+void Add(int n, T* dst, const T* src) {
+  int i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(dst + i, V::Add(V::Load(dst + i), V::Load(src + i)));
+  }
+  for (; i < n; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+void Sub(int n, T* dst, const T* src) {
+  int i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(dst + i, V::Sub(V::Load(dst + i), V::Load(src + i)));
+  }
+  for (; i < n; ++i) {
+    dst[i] -= src[i];
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+void Scale(int n, T* dst, T num) {
+  const typename V::Reg factor = V::Set1(num);
+  int i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(dst + i, V::Mul(V::Load(dst + i), factor));
+  }
+  for (; i < n; ++i) {
+    dst[i] *= num;
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+void Axpy(int n, T alpha, const T* src, T* dst) {
+  const typename V::Reg factor = V::Set1(alpha);
+  int i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(dst + i, V::Fmadd(factor, V::Load(src + i), V::Load(dst + i)));
+  }
+  for (; i < n; ++i) {
+    dst[i] += alpha * src[i];
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+bool Equal(int n, const T* a, const T* b, T eps) {
+  const typename V::Reg limit = V::Set1(eps);
+  int i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    if (V::AnyAbsGreater(V::Load(a + i), V::Load(b + i), limit)) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (std::abs(a[i] - b[i]) > eps) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class V, typename T = typename V::Scalar>
+T Dot(int n, const T* a, const T* b) {
+  // Два аккумулятора: следующее FMA не ждет результата предыдущего
+  typename V::Reg acc0 = V::Zero();
+  typename V::Reg acc1 = V::Zero();
+  int i = 0;
+  for (; i + 2 * V::kWidth <= n; i += 2 * V::kWidth) {
+    acc0 = V::Fmadd(V::Load(a + i), V::Load(b + i), acc0);
+    acc1 = V::Fmadd(V::Load(a + i + V::kWidth), V::Load(b + i + V::kWidth),
+                    acc1);
+  }
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    acc0 = V::Fmadd(V::Load(a + i), V::Load(b + i), acc0);
+  }
+  T lanes[V::kWidth];
+  V::Store(lanes, V::Add(acc0, acc1));
+  T sum = 0;
+  for (int lane = 0; lane < V::kWidth; ++lane) {
+    sum += lanes[lane];
+  }
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+// Микроядро умножения MR x (NV * kWidth). Аккумуляторы держатся в
+// регистрах, на каждом шаге k загружается одна строка панели B и
+// MR раз транслируется элемент панели A
+template <class V, int MR, int NV, typename T = typename V::Scalar>
+void GemmMicro(int kc, const T* a, const T* b, T* c, int ldc, int mr,
+               int nr) {
+  constexpr int kW = V::kWidth;
+  constexpr int kNR = NV * kW;
+  typename V::Reg acc[MR][NV];
+#pragma GCC unroll 16
+  for (int r = 0; r < MR; ++r) {
+#pragma GCC unroll 4
+    for (int v = 0; v < NV; ++v) {
+      acc[r][v] = V::Zero();
+    }
+  }
+
+  for (int p = 0; p < kc; ++p) {
+    typename V::Reg bv[NV];
+#pragma GCC unroll 4
+    for (int v = 0; v < NV; ++v) {
+      bv[v] = V::Load(b + v * kW);
+    }
+#pragma GCC unroll 16
+    for (int r = 0; r < MR; ++r) {
+      const typename V::Reg av = V::Set1(a[r]);
+#pragma GCC unroll 4
+      for (int v = 0; v < NV; ++v) {
+        acc[r][v] = V::Fmadd(av, bv[v], acc[r][v]);
+      }
+    }
+    a += MR;
+    b += kNR;
+  }
+
+  if (mr == MR && nr == kNR) {
+#pragma GCC unroll 16
+    for (int r = 0; r < MR; ++r) {
+      T* dst = c + static_cast<std::ptrdiff_t>(r) * ldc;
+#pragma GCC unroll 4
+      for (int v = 0; v < NV; ++v) {
+        V::Store(dst + v * kW, V::Add(V::Load(dst + v * kW), acc[r][v]));
+      }
+    }
+  } else {
+    // Неполный блок на краю матрицы: сохраняем во временный буфер
+    alignas(64) T tile[MR * kNR];
+    for (int r = 0; r < MR; ++r) {
+      for (int v = 0; v < NV; ++v) {
+        V::Store(tile + r * kNR + v * kW, acc[r][v]);
+      }
+    }
+    for (int r = 0; r < mr; ++r) {
+      T* dst = c + static_cast<std::ptrdiff_t>(r) * ldc;
+      for (int j = 0; j < nr; ++j) {
+        dst[j] += tile[r * kNR + j];
+      }
+    }
+  }
+}
+
+// Пакетные ядра (см. S21BasicMatrixBatch) работают со структурой
+// массивов: элемент (i, j) матрицы l лежит по адресу
+// data + (i * cols + j) * stride + l. Регистр охватывает kWidth соседних
+// матриц пакета, поэтому формулы записываются так же, как для одной
+// матрицы. Хвост пакета считается теми же формулами со скалярным
+// «регистром» ScalarLane<V>: он объявлен через V, чтобы экземпляры
+// разных единиц трансляции не смешивались
+
+template <class V>
+struct ScalarLane {
+  using Scalar = typename V::Scalar;
+  using Reg = Scalar;
+  static constexpr int kWidth = 1;
+
+  static Reg Zero() { return 0; }
+  static Reg Set1(Scalar x) { return x; }
+  static Reg Load(const Scalar* p) { return *p; }
+  static void Store(Scalar* p, Reg v) { *p = v; }
+  static Reg Add(Reg a, Reg b) { return a + b; }
+  static Reg Sub(Reg a, Reg b) { return a - b; }
+  static Reg Mul(Reg a, Reg b) { return a * b; }
+  static Reg Div(Reg a, Reg b) { return a / b; }
+  static Reg Fmadd(Reg a, Reg b, Reg c) { return a * b + c; }
+};
+
+// C(m x n) = A(m x k) * B(k x n) для kWidth матриц пакета
+template <class W, typename T>
+void BatchMulLanes(int m, int n, int k, const T* a, const T* b, T* c,
+                   std::ptrdiff_t stride) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      typename W::Reg acc = W::Zero();
+      for (int p = 0; p < k; ++p) {
+        acc = W::Fmadd(W::Load(a + (i * k + p) * stride),
+                       W::Load(b + (p * n + j) * stride), acc);
+      }
+      W::Store(c + (i * n + j) * stride, acc);
+    }
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+void BatchMul(int count, int m, int n, int k, const T* a, const T* b, T* c,
+              std::ptrdiff_t stride) {
+  int l = 0;
+  for (; l + V::kWidth <= count; l += V::kWidth) {
+    BatchMulLanes<V>(m, n, k, a + l, b + l, c + l, stride);
+  }
+  for (; l < count; ++l) {
+    BatchMulLanes<ScalarLane<V>>(m, n, k, a + l, b + l, c + l, stride);
+  }
+}
+
+// Присоединенная матрица adj[n * n] порядка n <= 4 по явным формулам (те
+// же, что в S21FixedMatrix::Adjugate) и определитель — первая строка A
+// на первый столбец adj
+template <class W, typename T>
+typename W::Reg BatchAdjugateLanes(int n, const T* a, std::ptrdiff_t stride,
+                                   typename W::Reg* adj) {
+  using Reg = typename W::Reg;
+  Reg e[4][4];
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      e[i][j] = W::Load(a + (i * n + j) * stride);
+    }
+  }
+  // x * y - z * w
+  auto d2 = [](Reg x, Reg y, Reg z, Reg w) {
+    return W::Sub(W::Mul(x, y), W::Mul(z, w));
+  };
+  // x * u - y * v + z * w
+  auto d3 = [](Reg x, Reg u, Reg y, Reg v, Reg z, Reg w) {
+    return W::Fmadd(z, w, W::Sub(W::Mul(x, u), W::Mul(y, v)));
+  };
+  auto neg = [](Reg x) { return W::Sub(W::Zero(), x); };
+  if (n == 1) {
+    adj[0] = W::Set1(1);
+  } else if (n == 2) {
+    adj[0] = e[1][1];
+    adj[1] = neg(e[0][1]);
+    adj[2] = neg(e[1][0]);
+    adj[3] = e[0][0];
+  } else if (n == 3) {
+    adj[0] = d2(e[1][1], e[2][2], e[1][2], e[2][1]);
+    adj[1] = d2(e[0][2], e[2][1], e[0][1], e[2][2]);
+    adj[2] = d2(e[0][1], e[1][2], e[0][2], e[1][1]);
+    adj[3] = d2(e[1][2], e[2][0], e[1][0], e[2][2]);
+    adj[4] = d2(e[0][0], e[2][2], e[0][2], e[2][0]);
+    adj[5] = d2(e[0][2], e[1][0], e[0][0], e[1][2]);
+    adj[6] = d2(e[1][0], e[2][1], e[1][1], e[2][0]);
+    adj[7] = d2(e[0][1], e[2][0], e[0][0], e[2][1]);
+    adj[8] = d2(e[0][0], e[1][1], e[0][1], e[1][0]);
+  } else {
+    const Reg s0 = d2(e[0][0], e[1][1], e[1][0], e[0][1]);
+    const Reg s1 = d2(e[0][0], e[1][2], e[1][0], e[0][2]);
+    const Reg s2 = d2(e[0][0], e[1][3], e[1][0], e[0][3]);
+    const Reg s3 = d2(e[0][1], e[1][2], e[1][1], e[0][2]);
+    const Reg s4 = d2(e[0][1], e[1][3], e[1][1], e[0][3]);
+    const Reg s5 = d2(e[0][2], e[1][3], e[1][2], e[0][3]);
+    const Reg c0 = d2(e[2][0], e[3][1], e[3][0], e[2][1]);
+    const Reg c1 = d2(e[2][0], e[3][2], e[3][0], e[2][2]);
+    const Reg c2 = d2(e[2][0], e[3][3], e[3][0], e[2][3]);
+    const Reg c3 = d2(e[2][1], e[3][2], e[3][1], e[2][2]);
+    const Reg c4 = d2(e[2][1], e[3][3], e[3][1], e[2][3]);
+    const Reg c5 = d2(e[2][2], e[3][3], e[3][2], e[2][3]);
+    adj[0] = d3(e[1][1], c5, e[1][2], c4, e[1][3], c3);
+    adj[1] = neg(d3(e[0][1], c5, e[0][2], c4, e[0][3], c3));
+    adj[2] = d3(e[3][1], s5, e[3][2], s4, e[3][3], s3);
+    adj[3] = neg(d3(e[2][1], s5, e[2][2], s4, e[2][3], s3));
+    adj[4] = neg(d3(e[1][0], c5, e[1][2], c2, e[1][3], c1));
+    adj[5] = d3(e[0][0], c5, e[0][2], c2, e[0][3], c1);
+    adj[6] = neg(d3(e[3][0], s5, e[3][2], s2, e[3][3], s1));
+    adj[7] = d3(e[2][0], s5, e[2][2], s2, e[2][3], s1);
+    adj[8] = d3(e[1][0], c4, e[1][1], c2, e[1][3], c0);
+    adj[9] = neg(d3(e[0][0], c4, e[0][1], c2, e[0][3], c0));
+    adj[10] = d3(e[3][0], s4, e[3][1], s2, e[3][3], s0);
+    adj[11] = neg(d3(e[2][0], s4, e[2][1], s2, e[2][3], s0));
+    adj[12] = neg(d3(e[1][0], c3, e[1][1], c1, e[1][2], c0));
+    adj[13] = d3(e[0][0], c3, e[0][1], c1, e[0][2], c0);
+    adj[14] = neg(d3(e[3][0], s3, e[3][1], s1, e[3][2], s0));
+    adj[15] = d3(e[2][0], s3, e[2][1], s1, e[2][2], s0);
+  }
+  Reg det = W::Zero();
+  for (int k = 0; k < n; ++k) {
+    det = W::Fmadd(e[0][k], adj[k * n], det);
+  }
+  return det;
+}
+
+// Определители пакета матриц порядка n <= 4
+template <class W, typename T>
+void BatchDeterminantLanes(int n, const T* a, T* det, std::ptrdiff_t stride) {
+  using Reg = typename W::Reg;
+  auto e = [a, n, stride](int i, int j) {
+    return W::Load(a + (i * n + j) * stride);
+  };
+  auto d2 = [&e](int i, int j, int k, int l) {
+    return W::Sub(W::Mul(e(i, j), e(k, l)), W::Mul(e(i, l), e(k, j)));
+  };
+  Reg result;
+  if (n == 1) {
+    result = e(0, 0);
+  } else if (n == 2) {
+    result = d2(0, 0, 1, 1);
+  } else if (n == 3) {
+    result = W::Fmadd(
+        e(0, 2), d2(1, 0, 2, 1),
+        W::Sub(W::Mul(e(0, 0), d2(1, 1, 2, 2)),
+               W::Mul(e(0, 1), d2(1, 0, 2, 2))));
+  } else {
+    // Разложение Лапласа по первым двум строкам
+    result = W::Mul(d2(0, 0, 1, 1), d2(2, 2, 3, 3));
+    result = W::Sub(result, W::Mul(d2(0, 0, 1, 2), d2(2, 1, 3, 3)));
+    result = W::Fmadd(d2(0, 0, 1, 3), d2(2, 1, 3, 2), result);
+    result = W::Fmadd(d2(0, 1, 1, 2), d2(2, 0, 3, 3), result);
+    result = W::Sub(result, W::Mul(d2(0, 1, 1, 3), d2(2, 0, 3, 2)));
+    result = W::Fmadd(d2(0, 2, 1, 3), d2(2, 0, 3, 1), result);
+  }
+  W::Store(det, result);
+}
+
+template <class V, typename T = typename V::Scalar>
+void BatchDeterminant(int count, int n, const T* a, T* det,
+                      std::ptrdiff_t stride) {
+  int l = 0;
+  for (; l + V::kWidth <= count; l += V::kWidth) {
+    BatchDeterminantLanes<V>(n, a + l, det + l, stride);
+  }
+  for (; l < count; ++l) {
+    BatchDeterminantLanes<ScalarLane<V>>(n, a + l, det + l, stride);
+  }
+}
+
+// Обратные матрицы adj(A) / det(A) порядка n <= 4. Определители
+// сохраняются в det, чтобы вызывающий код проверил вырожденность
+template <class W, typename T>
+void BatchInverseLanes(int n, const T* a, T* inverse, T* det,
+                       std::ptrdiff_t stride) {
+  typename W::Reg adj[16];
+  const typename W::Reg d = BatchAdjugateLanes<W>(n, a, stride, adj);
+  W::Store(det, d);
+  const typename W::Reg scale = W::Div(W::Set1(1), d);
+  for (int k = 0; k < n * n; ++k) {
+    W::Store(inverse + k * stride, W::Mul(adj[k], scale));
+  }
+}
+
+template <class V, typename T = typename V::Scalar>
+void BatchInverse(int count, int n, const T* a, T* inverse, T* det,
+                  std::ptrdiff_t stride) {
+  int l = 0;
+  for (; l + V::kWidth <= count; l += V::kWidth) {
+    BatchInverseLanes<V>(n, a + l, inverse + l, det + l, stride);
+  }
+  for (; l < count; ++l) {
+    BatchInverseLanes<ScalarLane<V>>(n, a + l, inverse + l, det + l, stride);
+  }
+}
+
+template <class V, int MR, int NV, typename T = typename V::Scalar>
+constexpr S21KernelTable<T> MakeKernels(S21Isa isa, const char* name) {
+  return S21KernelTable<T>{isa,
+                           name,
+                           &Add<V>,
+                           &Sub<V>,
+                           &Scale<V>,
+                           &Axpy<V>,
+                           &Equal<V>,
+                           &Dot<V>,
+                           MR,
+                           NV * V::kWidth,
+                           &GemmMicro<V, MR, NV>,
+                           &BatchMul<V>,
+                           &BatchDeterminant<V>,
+                           &BatchInverse<V>};
+}
+
+}  // namespace s21_kernels_impl
+
+#endif  // S21_MATRIX_KERNELS_IMPL_H
@@ -0,0 +1,75 @@
+// Ядра SSE2. Базовый набор любого x86-64 процессора, отдельные флаги
+// компиляции не нужны
+
+#include "s21_matrix_kernels_impl.h"
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+namespace {
+
+struct Sse2 {
+  using Scalar = double;
+  using Reg = __m128d;
+  static constexpr int kWidth = 2;
+
+  static Reg Zero() { return _mm_setzero_pd(); }
+  static Reg Set1(double x) { return _mm_set1_pd(x); }
+  static Reg Load(const double* p) { return _mm_loadu_pd(p); }
+  static void Store(double* p, Reg v) { _mm_storeu_pd(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm_div_pd(a, b); }
+  // В SSE2 нет FMA: умножение и сложение выполняются раздельно
+  static Reg Fmadd(Reg a, Reg b, Reg c) {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff = _mm_andnot_pd(_mm_set1_pd(-0.0), _mm_sub_pd(a, b));
+    return _mm_movemask_pd(_mm_cmpgt_pd(diff, eps)) != 0;
+  }
+};
+
+struct Sse2Float {
+  using Scalar = float;
+  using Reg = __m128;
+  static constexpr int kWidth = 4;
+
+  static Reg Zero() { return _mm_setzero_ps(); }
+  static Reg Set1(float x) { return _mm_set1_ps(x); }
+  static Reg Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+  static Reg Add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+  static Reg Fmadd(Reg a, Reg b, Reg c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+  static bool AnyAbsGreater(Reg a, Reg b, Reg eps) {
+    const Reg diff = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(a, b));
+    return _mm_movemask_ps(_mm_cmpgt_ps(diff, eps)) != 0;
+  }
+};
+
+// 4 x 4 (float: 4 x 8): 8 регистров-аккумуляторов из 16 доступных
+constexpr S21KernelTable<double> kSse2Kernels =
+    s21_kernels_impl::MakeKernels<Sse2, 4, 2>(S21Isa::kSse2, "sse2");
+constexpr S21KernelTable<float> kSse2KernelsF =
+    s21_kernels_impl::MakeKernels<Sse2Float, 4, 2>(S21Isa::kSse2, "sse2");
+
+}  // namespace
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Sse2Tables() {
+  return {&kSse2Kernels, &kSse2KernelsF};
+}
+
+#else
+
+s21_kernels_impl::IsaTables s21_kernels_impl::Sse2Tables() {
+  return {nullptr, nullptr};
+}
+
+#endif
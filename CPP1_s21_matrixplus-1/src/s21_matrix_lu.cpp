@@ -0,0 +1,278 @@
+#include "s21_matrix_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_solve.h"
+#include "s21_thread_pool.h"
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T>& matrix)
+    : lu_(matrix), pivots_(), sign_(1), singular_(false) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument(
+        "LU decomposition can only be calculated for square matrices.");
+  }
+
+  const int n = lu_.GetRows();
+  const int ld = lu_.GetStride();
+  T* a = lu_.data();
+  pivots_.resize(n);
+
+  for (int k = 0; k < n; ++k) {
+    // Ведущий элемент — наибольший по модулю в столбце k ниже диагонали
+    int pivot = k;
+    T best = std::fabs(a[static_cast<std::size_t>(k) * ld + k]);
+    for (int i = k + 1; i < n; ++i) {
+      const T value = std::fabs(a[static_cast<std::size_t>(i) * ld + k]);
+      if (value > best) {
+        best = value;
+        pivot = i;
+      }
+    }
+    pivots_[k] = pivot;
+
+    T* row_k = a + static_cast<std::size_t>(k) * ld;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + n,
+                       a + static_cast<std::size_t>(pivot) * ld);
+      sign_ = -sign_;
+    }
+
+    // Весь столбец под диагональю нулевой: исключать нечего
+    const T diag = row_k[k];
+    if (diag == 0) {
+      singular_ = true;
+      continue;
+    }
+
+    // Исключаем столбец k из строк ниже; строки обновляются независимо,
+    // поэтому большой остаток делится между потоками
+    const int tail = n - k - 1;
+    S21ParallelFor(tail, static_cast<long long>(tail) * tail,
+                   [&](int begin, int end) {
+                     for (int i = k + 1 + begin; i < k + 1 + end; ++i) {
+                       T* row_i = a + static_cast<std::size_t>(i) * ld;
+                       const T factor = row_i[k] / diag;
+                       row_i[k] = factor;
+                       if (factor != 0) {
+                         S21KernelAxpy(tail, -factor, row_k + k + 1,
+                                       row_i + k + 1);
+                       }
+                     }
+                   });
+  }
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const { return lu_.GetRows(); }
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const { return singular_; }
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  if (singular_) {
+    return 0;
+  }
+  T det = sign_;
+  for (int i = 0; i < lu_.GetRows(); ++i) {
+    det *= lu_(i, i);
+  }
+  return det;
+}
+
+template <typename T>
+T S21BasicLU<T>::MinPivot() const {
+  T result = std::numeric_limits<T>::infinity();
+  for (int i = 0; i < lu_.GetRows(); ++i) {
+    result = std::min(result, std::fabs(lu_(i, i)));
+  }
+  return result;
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicLU<T>::GetLU() const { return lu_; }
+
+template <typename T>
+const std::vector<int>& S21BasicLU<T>::GetPivots() const { return pivots_; }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  const int n = lu_.GetRows();
+  if (b.GetRows() != n) {
+    throw std::invalid_argument(
+        "The number of rows of the right-hand side must be equal to the "
+        "order of the matrix.");
+  }
+  if (singular_) {
+    throw std::invalid_argument(
+        "System cannot be solved for singular matrices (determinant is "
+        "zero).");
+  }
+
+  // Переставляем строки правой части так же, как строки A
+  S21BasicMatrix<T> x(b);
+  const int m = x.GetCols();
+  const int ldx = x.GetStride();
+  T* rows = x.data();
+  for (int k = 0; k < n; ++k) {
+    if (pivots_[k] != k) {
+      T* row_k = rows + static_cast<std::size_t>(k) * ldx;
+      std::swap_ranges(row_k, row_k + m,
+                       rows + static_cast<std::size_t>(pivots_[k]) * ldx);
+    }
+  }
+
+  // L * Y = P * B (единичная диагональ), затем U * X = Y
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kNo, true, n, m,
+                     lu_.data(), lu_.GetStride(), rows, ldx);
+  S21SolveTriangular(S21Triangle::kUpper, S21Transpose::kNo, false, n, m,
+                     lu_.data(), lu_.GetStride(), rows, ldx);
+  return x;
+}
+
+template <typename T>
+std::vector<T> S21BasicLU<T>::Solve(const std::vector<T>& b) const {
+  const int n = lu_.GetRows();
+  if (static_cast<int>(b.size()) != n) {
+    throw std::invalid_argument(
+        "The number of rows of the right-hand side must be equal to the "
+        "order of the matrix.");
+  }
+  if (singular_) {
+    throw std::invalid_argument(
+        "System cannot be solved for singular matrices (determinant is "
+        "zero).");
+  }
+  std::vector<T> x(b);
+  for (int k = 0; k < n; ++k) {
+    std::swap(x[k], x[pivots_[k]]);
+  }
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kNo, true, n, 1,
+                     lu_.data(), lu_.GetStride(), x.data(), 1);
+  S21SolveTriangular(S21Triangle::kUpper, S21Transpose::kNo, false, n, 1,
+                     lu_.data(), lu_.GetStride(), x.data(), 1);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  const int n = lu_.GetRows();
+  S21BasicMatrix<T> identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = 1;
+  }
+  return Solve(identity);
+}
+
+template <typename T>
+int S21RankRevealing(const S21BasicMatrix<T>& matrix,
+                     std::vector<T>* null_vector) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument(
+        "Rank can only be calculated for square matrices.");
+  }
+
+  const int n = matrix.GetRows();
+  S21BasicMatrix<T> work(matrix);
+  T* a = work.data();
+  const int ld = work.GetStride();
+  auto row = [a, ld](int i) { return a + static_cast<std::size_t>(i) * ld; };
+  // columns[j] — исходный номер столбца, стоящего на месте j
+  std::vector<int> columns(n);
+  std::iota(columns.begin(), columns.end(), 0);
+
+  T scale = 0;
+  for (int i = 0; i < n; ++i) {
+    const T* row_i = row(i);
+    for (int j = 0; j < n; ++j) {
+      scale = std::max(scale, std::fabs(row_i[j]));
+    }
+  }
+  const T tolerance = n * std::numeric_limits<T>::epsilon() * scale;
+
+  int rank = 0;
+  for (int k = 0; k < n; ++k) {
+    // Ведущий элемент — наибольший по модулю во всей оставшейся подматрице
+    int pivot_row = k;
+    int pivot_col = k;
+    T best = 0;
+    for (int i = k; i < n; ++i) {
+      const T* row_i = row(i);
+      for (int j = k; j < n; ++j) {
+        if (std::fabs(row_i[j]) > best) {
+          best = std::fabs(row_i[j]);
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (best <= tolerance) {
+      break;
+    }
+
+    T* row_k = row(k);
+    if (pivot_row != k) {
+      std::swap_ranges(row_k, row_k + n, row(pivot_row));
+    }
+    if (pivot_col != k) {
+      for (int i = 0; i < n; ++i) {
+        std::swap(row(i)[k], row(i)[pivot_col]);
+      }
+      std::swap(columns[k], columns[pivot_col]);
+    }
+
+    const int tail = n - k - 1;
+    for (int i = k + 1; i < n; ++i) {
+      T* row_i = row(i);
+      const T factor = row_i[k] / row_k[k];
+      row_i[k] = 0;
+      if (factor != 0) {
+        S21KernelAxpy(tail, -factor, row_k + k + 1, row_i + k + 1);
+      }
+    }
+    ++rank;
+  }
+
+  if (null_vector != nullptr && rank == n - 1) {
+    // Последняя переменная свободна: z[n-1] = 1, остальные находим
+    // обратным ходом по верхнетреугольному блоку ранга n - 1
+    std::vector<T> z(n, 0);
+    z[n - 1] = 1;
+    for (int k = n - 2; k >= 0; --k) {
+      const T* row_k = row(k);
+      T sum = 0;
+      for (int j = k + 1; j < n; ++j) {
+        sum += row_k[j] * z[j];
+      }
+      z[k] = -sum / row_k[k];
+    }
+    T norm = 0;
+    for (T value : z) {
+      norm += value * value;
+    }
+    norm = std::sqrt(norm);
+    null_vector->assign(n, 0);
+    for (int j = 0; j < n; ++j) {
+      (*null_vector)[columns[j]] = z[j] / norm;
+    }
+  }
+
+  return rank;
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
+
+template int S21RankRevealing(const S21BasicMatrix<float>&,
+                              std::vector<float>*);
+template int S21RankRevealing(const S21BasicMatrix<double>&,
+                              std::vector<double>*);
+template int S21RankRevealing(const S21BasicMatrix<long double>&,
+                              std::vector<long double>*);
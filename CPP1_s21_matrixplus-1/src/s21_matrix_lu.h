@@ -0,0 +1,72 @@
+#ifndef S21_MATRIX_LU_H
+#define S21_MATRIX_LU_H
+
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU-разложение квадратной матрицы с частичным выбором ведущего элемента:
+// P * A = L * U, где L — нижняя треугольная с единичной диагональю,
+// U — верхняя треугольная. Разложение считается один раз за O(n^3),
+// после чего определитель и решения систем получаются без повторного
+// разложения. Собрано для float, double и long double.
+template <typename T>
+class S21BasicLU {
+  static_assert(std::is_floating_point_v<T>,
+                "LU decomposition requires floating-point elements");
+
+ public:
+  // Раскладывает матрицу; бросает std::invalid_argument для неквадратной
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+
+  // Порядок матрицы
+  int GetSize() const;
+
+  // Есть ли на диагонали U нулевой элемент (определитель равен нулю)
+  bool IsSingular() const;
+
+  // Определитель: произведение диагонали U со знаком перестановки
+  T Determinant() const;
+
+  // L и U в одной матрице: L строго под диагональю, U на и над ней
+  const S21BasicMatrix<T>& GetLU() const;
+
+  // На шаге k строка k переставлялась со строкой GetPivots()[k]
+  const std::vector<int>& GetPivots() const;
+
+  // Решает A * X = B для всех столбцов B сразу за O(n^2) на столбец
+  // блочными треугольными решениями (s21_matrix_solve.h). Бросает
+  // std::invalid_argument, если число строк B не равно порядку или
+  // матрица вырождена
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+
+  // Обратная матрица: решение A * X = E
+  S21BasicMatrix<T> Inverse() const;
+
+  // Наименьший по модулю элемент диагонали U (мера близости к вырожденности)
+  T MinPivot() const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+};
+
+using S21LU = S21BasicLU<double>;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+
+// Численный ранг квадратной матрицы методом Гаусса с полным выбором
+// ведущего элемента. Элементы не больше n * epsilon(T) * max|a_ij|
+// считаются нулями. Если ранг равен n - 1 и null_vector не nullptr,
+// записывает в него вектор v единичной длины с A * v = 0
+template <typename T>
+int S21RankRevealing(const S21BasicMatrix<T>& matrix,
+                     std::vector<T>* null_vector);
+
+#endif  // S21_MATRIX_LU_H
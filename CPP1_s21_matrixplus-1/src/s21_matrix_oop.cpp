@@ -1,15 +1,272 @@
 #include "s21_matrix_oop.h"
 
-void S21Matrix::S21CreateMatrix(int rows, int cols) {
-  matrix_ = new double*[rows];
-  for (int i = 0; i < rows; ++i) {
-    matrix_[i] = new double[cols]();  // Инициализация нулями
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_file.h"
+#include "s21_matrix_fixed.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_solve.h"
+#include "s21_matrix_transpose.h"
+#include "s21_matrix_view.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// До этого порядка определитель, дополнения и обратная матрица считаются
+// явными формулами S21FixedMatrix: без циклов, выделения памяти под
+// миноры и проверок индексов. Формулы точны и для целочисленных матриц
+constexpr int kClosedFormMaxOrder = 4;
+
+// Считается ли матрица порядка n явными формулами. Пустая матрица (после
+// перемещения) сюда не относится: у нее нет элементов для копии
+constexpr bool HasClosedForm(int n) {
+  return n >= 1 && n <= kClosedFormMaxOrder;
+}
+
+// Вызывает op с копией матрицы n x n (HasClosedForm(n)) в
+// S21FixedMatrix<n, n, T>. Копия лежит на стеке, размер известен
+// компилятору, поэтому формулы развернуты и векторизуются
+template <typename T, typename Op>
+auto WithFixedMatrix(int n, const T* data, int stride, Op op) {
+  auto call = [&](auto order) {
+    constexpr int kN = decltype(order)::value;
+    S21FixedMatrix<kN, kN, T> fixed;
+    for (int i = 0; i < kN; ++i) {
+      for (int j = 0; j < kN; ++j) {
+        fixed(i, j) = data[static_cast<std::size_t>(i) * stride + j];
+      }
+    }
+    return op(fixed);
+  };
+  switch (n) {
+    case 1:
+      return call(std::integral_constant<int, 1>());
+    case 2:
+      return call(std::integral_constant<int, 2>());
+    case 3:
+      return call(std::integral_constant<int, 3>());
+    case 4:
+      return call(std::integral_constant<int, 4>());
+    default:
+      throw std::logic_error("No closed form for this matrix order");
+  }
+}
+
+// Записывает квадратную S21FixedMatrix в буфер с шагом stride
+template <int N, typename T>
+void StoreFixed(const S21FixedMatrix<N, N, T>& fixed, T* data, int stride) {
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      data[static_cast<std::size_t>(i) * stride + j] = fixed(i, j);
+    }
+  }
+}
+
+// Серия произведений квадратных матриц n x n (степень, экспонента).
+// Если S21Gemm выбрал бы для них Штрассена, его рабочая память выделяется
+// один раз на серию у текущего распределителя и передается каждому
+// произведению, а не выделяется в каждом S21Gemm заново
+template <typename T>
+class SquareProducts {
+ public:
+  explicit SquareProducts(int n) : n_(n), allocator_(S21GetAllocator()) {
+    if constexpr (kS21HasKernels<T>) {
+      if (n >= S21GetStrassenThreshold()) {
+        size_ = S21StrassenWorkspaceSize(n, n, n);
+      }
+      if (size_ > 0) {
+        workspace_ = static_cast<T*>(
+            allocator_->Allocate(size_ * sizeof(T), kWorkspaceAlignment));
+      }
+    }
+  }
+
+  ~SquareProducts() {
+    if (workspace_ != nullptr) {
+      allocator_->Deallocate(workspace_, size_ * sizeof(T),
+                             kWorkspaceAlignment);
+    }
+  }
+
+  SquareProducts(const SquareProducts&) = delete;
+  SquareProducts& operator=(const SquareProducts&) = delete;
+
+  // c = a * b; у всех трех матриц шаг строки ld
+  void Multiply(const T* a, const T* b, T* c, int ld) const {
+    if constexpr (kS21HasKernels<T>) {
+      if (workspace_ != nullptr) {
+        S21GemmStrassen(n_, n_, n_, a, ld, b, ld, c, ld, workspace_);
+        return;
+      }
+    }
+    S21Gemm(n_, n_, n_, a, ld, b, ld, c, ld);
+  }
+
+ private:
+  static constexpr std::size_t kWorkspaceAlignment = 64;
+
+  int n_;
+  S21Allocator* allocator_;
+  std::size_t size_ = 0;  // Элементов в workspace_
+  T* workspace_ = nullptr;
+};
+
+// Решение A * X = B для матрицы или вектора B: LU для квадратной A,
+// наименьшие квадраты через QR для переопределенной системы
+template <typename T, typename Rhs>
+Rhs SolveSystem(const S21BasicMatrix<T>& a, const Rhs& b) {
+  if constexpr (!std::is_floating_point_v<T>) {
+    throw std::invalid_argument(
+        "Systems can only be solved for floating-point matrices.");
+  } else {
+    if (a.GetRows() == a.GetCols()) {
+      return S21BasicLU<T>(a).Solve(b);
+    }
+    if (a.GetRows() < a.GetCols()) {
+      throw std::invalid_argument(
+          "System cannot be solved for matrices with fewer rows than "
+          "columns.");
+    }
+    return S21BasicQR<T>(a).Solve(b);
+  }
+}
+
+}  // namespace
+
+// Производные величины, посчитанные для одной версии содержимого
+template <typename T>
+struct S21BasicMatrix<T>::Cache {
+  // LU-разложение бывает только у матриц с плавающей точкой
+  using LU =
+      std::conditional_t<std::is_floating_point_v<T>, S21BasicLU<T>, char>;
+
+  unsigned long long version = 0;
+  std::optional<T> determinant;
+  std::optional<T> norm;
+  std::optional<LU> lu;
+  std::optional<S21BasicMatrix<T>> inverse;
+};
+
+namespace {
+
+// LU-разложение из кэша; считается при первом запросе
+template <typename Cache, typename T>
+const S21BasicLU<T>& CachedLU(Cache* cache, const S21BasicMatrix<T>& matrix) {
+  if (!cache->lu) {
+    cache->lu.emplace(matrix);
+  }
+  return *cache->lu;
+}
+
+}  // namespace
+
+template <typename T>
+typename S21BasicMatrix<T>::Cache* S21BasicMatrix<T>::FreshCache() const {
+  Cache* cache = cache_.get();
+  if (cache != nullptr && cache->version != version_) {
+    cache->determinant.reset();
+    cache->norm.reset();
+    cache->lu.reset();
+    cache->inverse.reset();
+    cache->version = version_;
+  }
+  return cache;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::EnableCache(bool enabled) {
+  if (!enabled) {
+    cache_.reset();
+  } else if (cache_ == nullptr) {
+    cache_ = std::make_unique<Cache>();
+    cache_->version = version_;
+  }
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsCacheEnabled() const { return cache_ != nullptr; }
+
+template <typename T>
+void S21BasicMatrix<T>::InvalidateCache() { Touch(); }
+
+template <typename T>
+unsigned long long S21BasicMatrix<T>::GetVersion() const { return version_; }
+
+template <typename T>
+int S21BasicMatrix<T>::AlignedStride(int cols) {
+  // Округляем длину строки вверх до целого числа кэш-линий
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  return (cols + per_line - 1) / per_line * per_line;
+}
+
+template <typename T>
+T* S21BasicMatrix<T>::AllocateBuffer(S21Allocator* allocator,
+                                     std::size_t count) {
+  T* buffer =
+      static_cast<T*>(allocator->Allocate(count * sizeof(T), kAlignment));
+  std::memset(buffer, 0, count * sizeof(T));  // Инициализация нулями
+  return buffer;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::DeallocateBuffer(S21Allocator* allocator, T* buffer,
+                                         std::size_t count) {
+  allocator->Deallocate(buffer, count * sizeof(T), kAlignment);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ParallelRows(
+    const std::function<void(int, int)>& body) const {
+  S21ParallelFor(rows_, Size(), body);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::S21CreateMatrix(int rows, int cols) {
+  // Одно выделение памяти на всю матрицу вместо отдельного на каждую строку
+  stride_ = AlignedStride(cols);
+  // Буфер возвращается в тот же распределитель, даже если поток к моменту
+  // освобождения сменил свой
+  allocator_ = S21GetAllocator();
+  matrix_ =
+      AllocateBuffer(allocator_, static_cast<std::size_t>(rows) * stride_);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::S21FreeMatrix() {
+  // Разделенный буфер освобождает последний владелец
+  if (share_ != nullptr) {
+    const bool last =
+        share_->owners.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    if (last) {
+      delete share_;
+    } else {
+      matrix_ = nullptr;
+    }
+    share_ = nullptr;
+  }
+  if (matrix_ != nullptr) {
+    DeallocateBuffer(allocator_, matrix_,
+                     static_cast<std::size_t>(rows_) * stride_);
+    matrix_ = nullptr;
   }
 }
 
-S21Matrix::S21Matrix() : rows_(3), cols_(3) { S21CreateMatrix(rows_, cols_); }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix() : rows_(3), cols_(3) {
+  S21CreateMatrix(rows_, cols_);
+}
 
-S21Matrix::S21Matrix(int rows, int cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols) {
   if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument(
         "Number of rows and columns must be greater than zero");
@@ -19,31 +276,154 @@ S21Matrix::S21Matrix(int rows, int cols) {
   S21CreateMatrix(rows, cols);
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  // Выделяем память для новой матрицы
-  S21CreateMatrix(rows_, cols_);
-
-  // Копируем данные из матрицы объекта other
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  if (other.share_ != nullptr) {
+    // Копирование при записи: разделяем буфер и режим
+    stride_ = other.stride_;
+    matrix_ = other.matrix_;
+    allocator_ = other.allocator_;
+    share_ = other.share_;
+    share_->owners.fetch_add(1, std::memory_order_relaxed);
+  } else if (other.matrix_ != nullptr) {
+    // Выделяем память для новой матрицы
+    S21CreateMatrix(rows_, cols_);
+
+    // Копируем данные из матрицы объекта other одним блоком
+    std::memcpy(matrix_, other.matrix_,
+                static_cast<std::size_t>(rows_) * stride_ * sizeof(T));
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(other.matrix_),
+      allocator_(other.allocator_),
+      version_(other.version_),
+      cache_(std::move(other.cache_)),
+      share_(other.share_) {
   // Обнуляем поля объекта other, чтобы он больше не владел ресурсами
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
   other.matrix_ = nullptr;
+  other.share_ = nullptr;
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMappedMatrix<T>&& mapped)
+    : rows_(mapped.GetRows()),
+      cols_(mapped.GetCols()),
+      stride_(0),
+      matrix_(nullptr),
+      allocator_(nullptr) {
+  if (mapped.data() == nullptr) {
+    throw std::invalid_argument("Matrix file mapping is empty");
+  }
+  if (mapped.GetStride() != AlignedStride(cols_)) {
+    // Шаг строки не как в памяти матрицы: строки копируются, а
+    // отображение снимает деструктор mapped
+    S21CreateMatrix(rows_, cols_);
+    for (int i = 0; i < rows_; ++i) {
+      std::memcpy(RowPtr(i), &mapped(i, 0), sizeof(T) * cols_);
+    }
+    return;
+  }
+  stride_ = mapped.GetStride();
+  T* data = mapped.data_;
+  allocator_ = mapped.Release();
+  matrix_ = data;
+  EnableCopyOnWrite();
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Detach() {
+  T* shared = matrix_;
+  S21Allocator* shared_allocator = allocator_;
+  Share* share = share_;
+  if (shared != nullptr) {
+    S21CreateMatrix(rows_, cols_);
+    std::memcpy(matrix_, shared,
+                static_cast<std::size_t>(rows_) * stride_ * sizeof(T));
+  }
+  share_ = new Share{1};
+  // Остальные копии могли быть уничтожены уже после проверки в Touch;
+  // тогда старый буфер освобождает эта матрица
+  if (share->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete share;
+    if (shared != nullptr) {
+      DeallocateBuffer(shared_allocator, shared,
+                       static_cast<std::size_t>(rows_) * stride_);
+    }
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::EnableCopyOnWrite(bool enabled) {
+  if (enabled) {
+    if (share_ == nullptr) {
+      share_ = new Share{1};
+    }
+  } else if (share_ != nullptr) {
+    if (IsShared()) {
+      Detach();
+    }
+    delete share_;
+    share_ = nullptr;
+  }
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsCopyOnWrite() const { return share_ != nullptr; }
+
+template <typename T>
+bool S21BasicMatrix<T>::IsShared() const {
+  return share_ != nullptr &&
+         share_->owners.load(std::memory_order_acquire) > 1;
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return this->rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return this->cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetStride() const { return this->stride_; }
+
+template <typename T>
+T* S21BasicMatrix<T>::data() {
+  Touch();
+  return matrix_;
 }
+template <typename T>
+const T* S21BasicMatrix<T>::data() const { return matrix_; }
 
-int S21Matrix::GetRows() const { return this->rows_; }
-int S21Matrix::GetCols() const { return this->cols_; }
+template <typename T>
+S21Span<T> S21BasicMatrix<T>::row(int i) {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Matrix row index is out of range");
+  }
+  Touch();
+  return S21Span<T>(RowPtr(i), cols_);
+}
+
+template <typename T>
+S21Span<const T> S21BasicMatrix<T>::row(int i) const {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Matrix row index is out of range");
+  }
+  return S21Span<const T>(RowPtr(i), cols_);
+}
 
-void S21Matrix::SetRows(int rows) {
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows < 1) {
     throw std::invalid_argument("Number of rows must be greater than 0");
   }
@@ -51,7 +431,8 @@ void S21Matrix::SetRows(int rows) {
   ResizeMatrix(rows, cols_);
 }
 
-void S21Matrix::SetCols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols < 1) {
     throw std::invalid_argument("Number of columns must be greater than 0");
   }
@@ -59,44 +440,40 @@ void S21Matrix::SetCols(int cols) {
   ResizeMatrix(rows_, cols);
 }
 
-void S21Matrix::ResizeMatrix(int new_rows, int new_cols) {
+template <typename T>
+void S21BasicMatrix<T>::ResizeMatrix(int new_rows, int new_cols) {
   // Создаем новую матрицу с новыми размерами
-  S21Matrix new_matrix(new_rows, new_cols);
-  // Копируем элементы из старой матрицы в новую
-  for (int i = 0; i < std::min(rows_, new_rows); ++i) {
-    for (int j = 0; j < std::min(cols_, new_cols); ++j) {
-      new_matrix.matrix_[i][j] = matrix_[i][j];
-    }
+  S21BasicMatrix new_matrix(new_rows, new_cols);
+  // Копируем общую часть строк из старой матрицы в новую
+  const int copy_rows = std::min(rows_, new_rows);
+  const std::size_t copy_bytes = std::min(cols_, new_cols) * sizeof(T);
+  for (int i = 0; i < copy_rows; ++i) {
+    std::memcpy(new_matrix.RowPtr(i), RowPtr(i), copy_bytes);
   }
   // Теперь используем конструктор перемещения для переноса результата
   *this = std::move(new_matrix);
 }
 
-S21Matrix::~S21Matrix() {
-  if (matrix_ != nullptr) {  // Если указатель не пустой, освобождаем память
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];  // Удаляем каждую строку
-    }
-    delete[] matrix_;  // Удаляем массив указателей
-  }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
+  S21FreeMatrix();  // Освобождаем единый буфер матрицы
   rows_ = 0;
   cols_ = 0;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) {
   bool result = true;
   // Проверяем размеры матриц
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     result = false;  // Если размеры не совпадают, матрицы не равны
   }
 
-  // Проверяем каждый элемент матрицы
+  // Проверяем каждую строку векторным ядром сравнения
   for (int i = 0; result && i < rows_; ++i) {
-    for (int j = 0; result && j < cols_; ++j) {
-      if (fabs(matrix_[i][j] - other.matrix_[i][j]) > EPS) {
-        result =
-            false;  // Если хотя бы один элемент не совпадает, матрицы не равны
-      }
+    if (!S21KernelEqual(cols_, RowPtr(i), other.RowPtr(i), EPS)) {
+      result =
+          false;  // Если хотя бы один элемент не совпадает, матрицы не равны
     }
   }
 
@@ -104,45 +481,53 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) {
   return result;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   // Проверяем, что размеры матриц совпадают
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument(
         "Matrices must have the same dimensions for addition.");
   }
 
-  // Поэлементное сложение
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
+  Touch();
+  // Поэлементное сложение; большие матрицы делятся на блоки строк
+  S21ParallelFor(rows_, Size(), [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      S21KernelAdd(cols_, RowPtr(i), other.RowPtr(i));
     }
-  }
+  });
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   // Проверяем, что размеры матриц совпадают
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument(
         "Matrices must have the same dimensions for addition.");
   }
 
-  // Поэлементное сложение
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
+  Touch();
+  // Поэлементное вычитание; большие матрицы делятся на блоки строк
+  S21ParallelFor(rows_, Size(), [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      S21KernelSub(cols_, RowPtr(i), other.RowPtr(i));
     }
-  }
+  });
 }
 
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  Touch();
+  S21ParallelFor(rows_, Size(), [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      S21KernelScale(cols_, RowPtr(i), num);
     }
-  }
+  });
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other,
+                                  S21MulAlgorithm algorithm) {
   // Проверяем возможность умножения матриц
   if (cols_ != other.rows_) {
     throw std::invalid_argument(
@@ -151,268 +536,620 @@ void S21Matrix::MulMatrix(const S21Matrix& other) {
   }
 
   // Создаем временную матрицу для хранения результата
-  S21Matrix result(rows_, other.cols_);
+  S21BasicMatrix result(rows_, other.cols_);
 
-  // Выполняем умножение матриц
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      result.matrix_[i][j] = 0;
-      for (int k = 0; k < cols_; ++k) {
-        result.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
+  // Выполняем умножение матриц: малые размеры считаются простым циклом,
+  // большие — блочным алгоритмом, очень большие — алгоритмом
+  // Штрассена-Винограда (см. s21_matrix_gemm.h)
+  S21Gemm(rows_, other.cols_, cols_, matrix_, stride_, other.matrix_,
+          other.stride_, result.matrix_, result.stride_, false, algorithm);
 
   // Теперь используем конструктор перемещения для переноса результата
   *this = std::move(result);  // Здесь вызывается конструктор перемещения
 }
 
-S21Matrix S21Matrix::Transpose() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
   // Создаем новую матрицу размером cols_ x rows_ (транспонированную)
-  S21Matrix result(cols_, rows_);
+  S21BasicMatrix result(cols_, rows_);
 
-  // Перемещаем элементы: строка -> столбец и столбец -> строка
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result.matrix_[j][i] = matrix_[i][j];  // Меняем строки и столбцы местами
-    }
-  }
+  // Потоки получают полосы столбцов исходной матрицы — строки результата —
+  // и не пишут в общие строки; полоса транспонируется рекурсивными блоками
+  S21ParallelFor(cols_, Size(), [&](int begin, int end) {
+    S21TransposeCopy(rows_, end - begin, matrix_ + begin, stride_,
+                     result.RowPtr(begin), result.stride_);
+  });
 
   // Возвращаем транспонированную матрицу
   return result;
 }
 
-S21Matrix S21Matrix::GetMinor(int row, int col) const {
-  S21Matrix minor(rows_ - 1, cols_ - 1);
-
-  for (int i = 0, minor_i = 0; i < rows_; ++i) {
-    if (i == row) continue;  // Пропускаем строку row
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (rows_ == cols_) {
+    Touch();
+    S21TransposeInPlace(rows_, matrix_, stride_);
+  } else {
+    *this = Transpose();
+  }
+}
 
-    for (int j = 0, minor_j = 0; j < cols_; ++j) {
-      if (j == col) continue;  // Пропускаем столбец col
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::TransposeView() const {
+  return S21BasicMatrixView<const T>(*this).Transpose();
+}
 
-      minor.matrix_[minor_i][minor_j] = matrix_[i][j];
-      minor_j++;
+template <typename T>
+T S21BasicMatrix<T>::BareissDeterminant() const {
+  S21BasicMatrix work(*this);
+  // Строки пишутся напрямую, поэтому буфер не должен быть разделен
+  work.Touch();
+  const int n = rows_;
+  T sign = 1;
+  T previous = 1;
+  for (int k = 0; k < n - 1; ++k) {
+    T* row_k = work.RowPtr(k);
+    if (row_k[k] == 0) {
+      // Ищем ниже строку с ненулевым элементом в столбце k
+      int pivot = k + 1;
+      while (pivot < n && work.RowPtr(pivot)[k] == 0) {
+        ++pivot;
+      }
+      if (pivot == n) {
+        return 0;
+      }
+      std::swap_ranges(row_k + k, row_k + n, work.RowPtr(pivot) + k);
+      sign = -sign;
+    }
+    // После шага k элемент (i, j) равен минору порядка k + 2, поэтому
+    // деление на предыдущий ведущий элемент всегда выполняется нацело
+    for (int i = k + 1; i < n; ++i) {
+      T* row_i = work.RowPtr(i);
+      for (int j = k + 1; j < n; ++j) {
+        row_i[j] = (row_i[j] * row_k[k] - row_i[k] * row_k[j]) / previous;
+      }
     }
-    minor_i++;
+    previous = row_k[k];
   }
-
-  return minor;
+  return sign * work.RowPtr(n - 1)[n - 1];
 }
 
-double S21Matrix::Determinant() {
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
   // Проверяем, что матрица квадратная
   if (rows_ != cols_) {
     throw std::invalid_argument(
         "Determinant can only be calculated for square matrices.");
   }
-
-  // Базовый случай: определитель матрицы 1x1 — это сам элемент
-  if (rows_ == 1) {
-    return matrix_[0][0];
+  // Пустая матрица (после перемещения) — определитель 0, как раньше
+  if (rows_ == 0) {
+    return 0;
   }
 
-  // Базовый случай: определитель матрицы 2x2
-  if (rows_ == 2) {
-    return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+  Cache* cache = FreshCache();
+  if (cache != nullptr && cache->determinant) {
+    return *cache->determinant;
   }
 
-  // Рекурсивный случай: разложение определителя по первой строке
-  double det = 0.0;
-
-  for (int j = 0; j < cols_; ++j) {
-    // Вычисляем минор для элемента matrix_[0][j]
-    S21Matrix minor = GetMinor(0, j);
-
-    // Определяем знак для члена разложения
-    double sign = (j % 2 == 0) ? 1.0 : -1.0;
-
-    // Рекурсивно вычисляем определитель минорной матрицы
-    det += sign * matrix_[0][j] * minor.Determinant();
+  T det;
+  if (HasClosedForm(rows_)) {
+    // Малые порядки: явные формулы
+    det = WithFixedMatrix(rows_, matrix_, stride_, [](const auto& fixed) {
+      return fixed.Determinant();
+    });
+  } else if constexpr (std::is_floating_point_v<T>) {
+    // Общий случай: LU-разложение с выбором ведущего элемента за O(n^3)
+    // вместо рекурсивного разложения по строке за O(n!). С кэшем
+    // разложение сохраняется для InverseMatrix и Solve
+    det = cache != nullptr ? CachedLU(cache, *this).Determinant()
+                           : S21BasicLU<T>(*this).Determinant();
+  } else {
+    // Для целых типов деления LU неточны, поэтому используется метод
+    // Барейса
+    det = BareissDeterminant();
+  }
+  if (cache != nullptr) {
+    cache->determinant = det;
   }
-
   return det;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
   // Проверяем, что матрица квадратная
   if (rows_ != cols_) {
     throw std::invalid_argument(
         "Complements can only be calculated for square matrices.");
   }
 
-  // Создаем матрицу для хранения алгебраических дополнений
-  S21Matrix result(rows_, cols_);
+  if (rows_ > kClosedFormMaxOrder) {
+    return ComplementsFromLU();
+  }
+
+  // Малые порядки: явные формулы присоединенной матрицы. Для пустой
+  // матрицы конструктор результата бросает std::invalid_argument
+  S21BasicMatrix result(rows_, cols_);
+  WithFixedMatrix(rows_, matrix_, stride_, [&result](const auto& fixed) {
+    StoreFixed(fixed.CalcComplements(), result.matrix_, result.stride_);
+  });
+  return result;
+}
 
-  // Вычисляем алгебраическое дополнение для каждого элемента
+template <typename T>
+T S21BasicMatrix<T>::Cofactor(int row, int col) const {
+  // Минор для элемента (row, col) — вид без копирования элементов: до
+  // порядка 3 его определитель считается прямо по памяти матрицы
+  const S21BasicConstMatrixView<T> minor =
+      S21BasicConstMatrixView<T>(*this).Minor(row, col);
+  // Вычисляем знак (-1)^(row+col)
+  T sign = ((row + col) % 2 == 0) ? 1 : -1;
+  // Вычисляем алгебраическое дополнение: знак * определитель минора
+  return sign * minor.Determinant();
+}
+
+template <typename T>
+T S21BasicMatrix<T>::PivotTolerance() const {
+  T scale = 0;
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      // Вычисляем минор для элемента (i, j)
-      S21Matrix minor = GetMinor(i, j);
-      // Вычисляем знак (-1)^(i+j)
-      double sign = ((i + j) % 2 == 0) ? 1.0 : -1.0;
-      // Вычисляем алгебраическое дополнение: знак * определитель минора
-      result.matrix_[i][j] = sign * minor.Determinant();
+    for (T value : row(i)) {
+      scale = std::max(scale, value < 0 ? -value : value);
     }
   }
+  return rows_ * std::numeric_limits<T>::epsilon() * scale;
+}
 
-  return result;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::ComplementsFromLU() const {
+  if constexpr (!std::is_floating_point_v<T>) {
+    // Для целых типов LU неприменимо: дополнения считаются через миноры
+    S21BasicMatrix result(rows_, cols_);
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        result.RowPtr(i)[j] = Cofactor(i, j);
+      }
+    }
+    return result;
+  } else {
+    const T tolerance = PivotTolerance();
+
+    // Невырожденная матрица: C = det(A) * (A^-1)^T
+    S21BasicLU<T> lu(*this);
+    auto from_inverse = [&lu] {
+      S21BasicMatrix result = lu.Inverse().Transpose();
+      result.MulNumber(lu.Determinant());
+      return result;
+    };
+    if (!lu.IsSingular() && lu.MinPivot() > tolerance) {
+      return from_inverse();
+    }
+
+    // Малый ведущий элемент частичного выбора еще не означает
+    // вырожденности: ранг уточняется полным выбором
+    std::vector<T> v;
+    const int rank = S21RankRevealing(*this, &v);
+    if (rank == rows_ && !lu.IsSingular()) {
+      return from_inverse();
+    }
+
+    // Вырожденная матрица. При ранге меньше n - 1 все миноры порядка n - 1
+    // нулевые. При ранге n - 1 присоединенная матрица имеет ранг 1:
+    // adj(A) = g * v * u^T, где A * v = 0 и u^T * A = 0, поэтому
+    // C = g * u * v^T, а множитель g находим по одному дополнению
+    S21BasicMatrix result(rows_, cols_);
+    std::vector<T> u;
+    if (rank != rows_ - 1) {
+      return result;
+    }
+    S21BasicMatrix transposed(*this);
+    transposed.TransposeInPlace();
+    S21RankRevealing(transposed, &u);
+
+    const int i = static_cast<int>(
+        std::max_element(u.begin(), u.end(),
+                         [](T a, T b) {
+                           return std::fabs(a) < std::fabs(b);
+                         }) -
+        u.begin());
+    const int j = static_cast<int>(
+        std::max_element(v.begin(), v.end(),
+                         [](T a, T b) {
+                           return std::fabs(a) < std::fabs(b);
+                         }) -
+        v.begin());
+    const T g = Cofactor(i, j) / (u[i] * v[j]);
+    for (int r = 0; r < rows_; ++r) {
+      T* dst = result.RowPtr(r);
+      for (int c = 0; c < cols_; ++c) {
+        dst[c] = g * u[r] * v[c];
+      }
+    }
+    return result;
+  }
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  Cache* cache = FreshCache();
+  if (cache == nullptr) {
+    return CalcInverse(nullptr);
+  }
+  if (!cache->inverse) {
+    cache->inverse = CalcInverse(cache);
+  }
+  return *cache->inverse;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcInverse(Cache* cache) {
   // Проверяем, что матрица квадратная
   if (rows_ != cols_) {
     throw std::invalid_argument(
         "Inverse matrix can only be calculated for square matrices.");
   }
+  // У пустой матрицы определитель 0, и обратной нет
+  if (rows_ == 0) {
+    throw std::invalid_argument(
+        "Inverse matrix does not exist for singular matrices (determinant is "
+        "zero).");
+  }
+
+  // Малые порядки: присоединенная матрица, деленная на определитель, по
+  // явным формулам. Ошибки те же, что и в общем случае
+  if (HasClosedForm(rows_)) {
+    S21BasicMatrix result(rows_, cols_);
+    WithFixedMatrix(rows_, matrix_, stride_, [&result](const auto& fixed) {
+      StoreFixed(fixed.InverseMatrix(), result.matrix_, result.stride_);
+    });
+    return result;
+  }
+
+  // Большие матрицы обращаем через LU-разложение за O(n^3); с кэшем
+  // разложение берется оттуда
+  if constexpr (std::is_floating_point_v<T>) {
+    std::optional<S21BasicLU<T>> own;
+    const S21BasicLU<T>& lu =
+        cache != nullptr ? CachedLU(cache, *this) : own.emplace(*this);
+    // Ведущий элемент на уровне ошибок округления: матрица вырождена, а
+    // ненулевой он только из-за порядка вычислений
+    if (lu.IsSingular() || lu.MinPivot() <= PivotTolerance()) {
+      throw std::invalid_argument(
+          "Inverse matrix does not exist for singular matrices "
+          "(determinant is zero).");
+    }
+    return lu.Inverse();
+  }
 
   // Вычисляем определитель матрицы
-  double det = this->Determinant();
+  T det = this->Determinant();
   if (det == 0) {
     throw std::invalid_argument(
         "Inverse matrix does not exist for singular matrices (determinant is "
         "zero).");
   }
 
+  // Обратная к целой матрице целая, только если определитель равен 1 или -1
+  if constexpr (std::is_integral_v<T>) {
+    if (det != 1 && det != -1) {
+      throw std::invalid_argument(
+          "Inverse of an integer matrix exists only if the determinant is 1 "
+          "or -1.");
+    }
+  }
+
   // Вычисляем матрицу алгебраических дополнений
-  S21Matrix complements = this->CalcComplements();
+  S21BasicMatrix complements = this->CalcComplements();
 
   // Транспонируем матрицу алгебраических дополнений
-  S21Matrix transposed = complements.Transpose();
+  S21BasicMatrix transposed = complements.Transpose();
 
   // Делим каждый элемент транспонированной матрицы на определитель
   for (int i = 0; i < transposed.rows_; ++i) {
+    T* dst = transposed.RowPtr(i);
     for (int j = 0; j < transposed.cols_; ++j) {
-      transposed.matrix_[i][j] /= det;
+      dst[j] /= det;
     }
   }
 
   return transposed;
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  // Создаем копию текущей матрицы
-  S21Matrix result(*this);
-
-  // Используем функцию SumMatrix для сложения
-  result.SumMatrix(other);
-
-  return result;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrix& b) const {
+  if constexpr (std::is_floating_point_v<T>) {
+    // С кэшем квадратная система решается сохраненным LU за O(n^2)
+    Cache* cache = FreshCache();
+    if (cache != nullptr && rows_ == cols_) {
+      return CachedLU(cache, *this).Solve(b);
+    }
+  }
+  return SolveSystem(*this, b);
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix result(*this);
-
-  // Используем функцию SubMatrix для вычитания
-  result.SubMatrix(other);
-
-  return result;
+template <typename T>
+std::vector<T> S21BasicMatrix<T>::Solve(const std::vector<T>& b) const {
+  if constexpr (std::is_floating_point_v<T>) {
+    Cache* cache = FreshCache();
+    if (cache != nullptr && rows_ == cols_) {
+      return CachedLU(cache, *this).Solve(b);
+    }
+  }
+  return SolveSystem(*this, b);
 }
 
-S21Matrix S21Matrix::operator*(const double num) {
-  // Создаем копию текущей матрицы
-  S21Matrix result(*this);
+template <typename T>
+T S21BasicMatrix<T>::Norm() const {
+  Cache* cache = FreshCache();
+  if (cache != nullptr && cache->norm) {
+    return *cache->norm;
+  }
+  T norm = 0;
+  for (int i = 0; i < rows_; ++i) {
+    T sum = 0;
+    for (T value : row(i)) {
+      sum += value < 0 ? -value : value;
+    }
+    norm = std::max(norm, sum);
+  }
+  if (cache != nullptr) {
+    cache->norm = norm;
+  }
+  return norm;
+}
 
-  // Используем функцию MulNumber для умножения
-  result.MulNumber(num);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Pow(int k) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix power can only be calculated for square matrices.");
+  }
+  const int n = rows_;
+  // A^-k = (A^-1)^k
+  S21BasicMatrix base =
+      k < 0 ? S21BasicMatrix(*this).InverseMatrix() : S21BasicMatrix(*this);
+  unsigned long long exponent =
+      k < 0 ? 0ULL - static_cast<unsigned long long>(k)
+            : static_cast<unsigned long long>(k);
+  S21BasicMatrix result(n, n);
+  if (exponent == 0) {
+    for (int i = 0; i < n; ++i) {
+      result.RowPtr(i)[i] = 1;
+    }
+    return result;
+  }
 
-  // Возвращаем результат
-  return result;
+  // result = base^(сумма пройденных битов), base = A^(2^бит); новое
+  // произведение пишется в temp и меняется с операндом местами
+  S21BasicMatrix temp(n, n);
+  const SquareProducts<T> products(n);
+  bool first = true;
+  while (true) {
+    if (exponent & 1) {
+      if (first) {
+        result = base;
+        first = false;
+      } else {
+        products.Multiply(result.matrix_, base.matrix_, temp.matrix_,
+                          stride_);
+        std::swap(result, temp);
+      }
+    }
+    exponent >>= 1;
+    if (exponent == 0) {
+      return result;
+    }
+    products.Multiply(base.matrix_, base.matrix_, temp.matrix_, stride_);
+    std::swap(base, temp);
+  }
 }
 
-S21Matrix operator*(const double num, S21Matrix& matrix) {
-  S21Matrix result(matrix.GetRows(), matrix.GetCols());
-  for (int i = 0; i < matrix.GetRows(); ++i) {
-    for (int j = 0; j < matrix.GetCols(); ++j) {
-      result(i, j) = matrix(i, j) * num;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Expm() const {
+  if constexpr (!std::is_floating_point_v<T>) {
+    throw std::invalid_argument(
+        "Matrix exponential can only be calculated for floating-point "
+        "matrices.");
+  } else {
+    if (rows_ != cols_) {
+      throw std::invalid_argument(
+          "Matrix exponential can only be calculated for square matrices.");
+    }
+    const int n = rows_;
+    const T norm = Norm();
+    if (!std::isfinite(norm)) {
+      throw std::invalid_argument(
+          "Matrix exponential requires finite matrix elements.");
     }
+    // norm < 2^e, поэтому после деления на 2^(e + 1) норма меньше 1/2
+    int exponent = 0;
+    std::frexp(norm, &exponent);
+    const int squarings = std::max(0, exponent + 1);
+    S21BasicMatrix a(*this);
+    a.MulNumber(std::ldexp(T(1), -squarings));
+
+    // Паде порядка (q, q): N(A) = sum c_j A^j, D(A) = sum (-1)^j c_j A^j,
+    // c_j = c_{j-1} (q - j + 1) / (j (2q - j + 1)). При ||A|| <= 1/2
+    // относительная погрешность не больше 3.4e-16 для q = 6 и 2.6e-23
+    // для q = 8 (Golub, Van Loan, "Matrix Computations", 11.3)
+    const int q = std::numeric_limits<T>::digits > 53 ? 8 : 6;
+    S21BasicMatrix numerator(n, n);
+    S21BasicMatrix denominator(n, n);
+    for (int i = 0; i < n; ++i) {
+      numerator.RowPtr(i)[i] = 1;
+      denominator.RowPtr(i)[i] = 1;
+    }
+    S21BasicMatrix power(a);  // A^j
+    S21BasicMatrix temp(n, n);
+    const SquareProducts<T> products(n);
+    T c = 1;
+    for (int j = 1; j <= q; ++j) {
+      c = c * (q - j + 1) / (j * (2 * q - j + 1));
+      if (j > 1) {
+        products.Multiply(a.matrix_, power.matrix_, temp.matrix_, stride_);
+        std::swap(power, temp);
+      }
+      for (int i = 0; i < n; ++i) {
+        S21KernelAxpy(n, c, power.RowPtr(i), numerator.RowPtr(i));
+        S21KernelAxpy(n, j % 2 == 0 ? c : -c, power.RowPtr(i),
+                      denominator.RowPtr(i));
+      }
+    }
+
+    // e^(A / 2^s) = D^-1 * N; возводим в квадрат s раз
+    S21BasicMatrix result = S21BasicLU<T>(denominator).Solve(numerator);
+    for (int step = 0; step < squarings; ++step) {
+      products.Multiply(result.matrix_, result.matrix_, temp.matrix_,
+                        stride_);
+      std::swap(result, temp);
+    }
+    return result;
   }
-  return result;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix result(*this);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const S21BasicMatrix& other) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
 
-  // Используем функцию MulMatrix для умножения
-  result.MulMatrix(other);
+  // Считаем произведение сразу в результат, без копии левого операнда
+  S21BasicMatrix result(rows_, other.cols_);
+  S21Gemm(rows_, other.cols_, cols_, matrix_, stride_, other.matrix_,
+          other.stride_, result.matrix_, result.stride_);
 
   return result;
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) { return EqMatrix(other); }
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) {
+  return EqMatrix(other);
+}
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
   // Проверка на самоприсваивание
   if (this != &other) {
-    // Освобождаем старую память
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
+    // Элементы перезаписываются целиком, поэтому разделенный буфер не
+    // копируется, а отпускается
+    ++version_;
+    const bool copy_on_write = share_ != nullptr;
+    if (copy_on_write && other.share_ != nullptr) {
+      other.share_->owners.fetch_add(1, std::memory_order_relaxed);
+      S21FreeMatrix();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      stride_ = other.stride_;
+      matrix_ = other.matrix_;
+      allocator_ = other.allocator_;
+      share_ = other.share_;
+      return *this;
+    }
+    if (IsShared()) {
+      S21FreeMatrix();
+    }
+    // Переиспользуем буфер, если его размер уже подходит
+    const bool same_shape = matrix_ != nullptr && rows_ == other.rows_ &&
+                            stride_ == AlignedStride(other.cols_);
+    if (!same_shape) {
+      // Освобождаем старую память
+      S21FreeMatrix();
+      stride_ = 0;
+      if (other.matrix_ != nullptr) {
+        // Выделяем новую память для копирования данных
+        S21CreateMatrix(other.rows_, other.cols_);
+      }
     }
-    delete[] matrix_;
 
     // Копируем размеры матрицы
     rows_ = other.rows_;
     cols_ = other.cols_;
 
-    // Выделяем новую память для копирования данных
-    matrix_ = new double*[rows_];
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_];
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
+    // Копируем данные одним блоком
+    if (other.matrix_ != nullptr) {
+      std::memcpy(matrix_, other.matrix_,
+                  static_cast<std::size_t>(rows_) * stride_ * sizeof(T));
     }
+    EnableCopyOnWrite(copy_on_write);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21BasicMatrix&& other) {
   if (this != &other) {  // Защита от самоприсваивания
+    // Содержимое меняется, а настройки кэша и копирования при записи
+    // остаются прежними
+    ++version_;
+    const bool copy_on_write = share_ != nullptr;
     // Освобождаем ресурсы текущего объекта
-    if (matrix_ != nullptr) {
-      for (int i = 0; i < rows_; ++i) {
-        delete[] matrix_[i];
-      }
-      delete[] matrix_;
-    }
+    S21FreeMatrix();
 
     // Копируем данные из другого объекта
     rows_ = other.rows_;
     cols_ = other.cols_;
+    stride_ = other.stride_;
     matrix_ = other.matrix_;
+    allocator_ = other.allocator_;
 
     // Обнуляем другой объект, чтобы избежать повторного удаления
     other.rows_ = 0;
     other.cols_ = 0;
+    other.stride_ = 0;
     other.matrix_ = nullptr;
+    share_ = other.share_;
+    other.share_ = nullptr;
+    EnableCopyOnWrite(copy_on_write);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(double num) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(T num) {
   MulNumber(num);
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) {
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
   // Проверяем допустимость индексов
   if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
     throw std::out_of_range("Matrix indices are out of range");
   }
-  return matrix_[i][j];
+  // Через ссылку элемент может измениться
+  Touch();
+  return RowPtr(i)[j];
 }
+
+template <typename T>
+const T& S21BasicMatrix<T>::operator()(int i, int j) const {
+  // Проверяем допустимость индексов
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return RowPtr(i)[j];
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<int>;
+template class S21BasicMatrix<std::int64_t>;
@@ -2,68 +2,346 @@
 #define S21_MATRIX_OOP_H
 
 #include <cmath>
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_gemm.h"
+
+// Невладеющий вид на непрерывный участок памяти (аналог std::span из C++20)
+template <typename T>
+class S21Span {
+ public:
+  S21Span(T* data, int size) : data_(data), size_(size) {}
+
+  T* data() const { return data_; }
+  int size() const { return size_; }
+  T& operator[](int i) const { return data_[i]; }
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+
+ private:
+  T* data_;
+  int size_;
+};
+
+// Допуск сравнения в EqMatrix для типа элементов. Целые матрицы
+// сравниваются точно
+template <typename T>
+struct S21MatrixTraits {
+  static constexpr T kEpsilon = 0;
+};
+
+template <>
+struct S21MatrixTraits<float> {
+  static constexpr float kEpsilon = 1e-4f;
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  static constexpr double kEpsilon = 1e-6;
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  static constexpr long double kEpsilon = 1e-9L;
+};
+
+// Режим отображения файла матрицы в память (см. s21_matrix_file.h):
+// только чтение или копирование при записи — изменения видны только
+// этому отображению и не попадают в файл
+enum class S21MapMode { kReadOnly, kCopyOnWrite };
+
+template <typename T>
+class S21BasicMappedMatrix;
+
+template <typename T>
+class S21BasicMatrixView;
+
+// Матрица с элементами типа T. Библиотека собрана для float, double,
+// long double, int и std::int64_t: float и double используют векторные
+// ядра, остальные типы — простые циклы. Для целых типов определитель и
+// дополнения считаются точно, а обратная матрица существует, только если
+// определитель равен 1 или -1
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "Matrix elements must be numbers");
+
+ public:
+  using value_type = T;
+
+  // Выравнивание буфера и начала каждой строки (размер кэш-линии в байтах)
+  static constexpr std::size_t kAlignment = 64;
 
-class S21Matrix {
  private:
   // Attributes
   int rows_, cols_;  // Rows and columns
-  double** matrix_;  // Pointer to the memory where the matrix is allocated
-  const double EPS{1e-6};
+  int stride_;       // Шаг между строками в элементах (cols_ с выравниванием)
+  T* matrix_;        // Единый выровненный буфер из rows_ * stride_ элементов
+  S21Allocator* allocator_;  // Распределитель, выделивший matrix_
+  static constexpr T EPS = S21MatrixTraits<T>::kEpsilon;
+
+  // Сохраненные производные величины (определен в s21_matrix_oop.cpp)
+  struct Cache;
+
+  // Номер версии содержимого: каждый изменяющий метод увеличивает его, и
+  // величины, сохраненные для другой версии, считаются устаревшими
+  unsigned long long version_ = 0;
+  // Кэш производных величин; nullptr, пока кэш не включен. Заполняется
+  // и константными методами
+  std::unique_ptr<Cache> cache_;
+
+  // Счетчик владельцев буфера, разделенного копиями в режиме
+  // копирования при записи
+  struct Share {
+    std::atomic<int> owners;
+  };
+  // nullptr — режим выключен и буфер принадлежит только этой матрице
+  Share* share_ = nullptr;
+
+  // Отмечает изменение содержимого; разделенный буфер перед записью
+  // копируется
+  void Touch() {
+    ++version_;
+    if (share_ != nullptr &&
+        share_->owners.load(std::memory_order_acquire) > 1) {
+      Detach();
+    }
+  }
+
+  // Заменяет разделенный буфер собственной копией
+  void Detach();
+
+  // Кэш текущей версии (устаревшие величины сброшены) или nullptr, если
+  // кэш выключен
+  Cache* FreshCache() const;
+
+  // Обратная матрица без обращения к сохраненной; LU-разложение берется
+  // из cache, если он задан
+  S21BasicMatrix CalcInverse(Cache* cache);
 
   // Приватная функция для создания матрицы
   void S21CreateMatrix(int rows, int cols);
 
+  // Приватная функция для освобождения памяти матрицы
+  void S21FreeMatrix();
+
   // Приватная функция для пересоздания матрицы
   void ResizeMatrix(int new_rows, int new_cols);
 
-  // Приватная функция для получение минора
-  S21Matrix GetMinor(int row, int col) const;
+  // Алгебраическое дополнение элемента (row, col) через минор
+  T Cofactor(int row, int col) const;
+
+  // Порог вырожденности n * eps * max|a_ij| для наименьшего ведущего
+  // элемента LU-разложения
+  T PivotTolerance() const;
+
+  // Матрица алгебраических дополнений через LU-разложение для больших
+  // матриц; для вырожденных — через ранг и векторы ядра, для целых
+  // типов — через миноры
+  S21BasicMatrix ComplementsFromLU() const;
+
+  // Точный определитель целой матрицы методом Барейса: промежуточные
+  // значения — миноры исходной матрицы, поэтому все деления нацело
+  T BareissDeterminant() const;
+
+  // Указатель на начало строки i без проверки индекса
+  T* RowPtr(int i) const {
+    return matrix_ + static_cast<std::size_t>(i) * stride_;
+  }
+
+  // Число элементов матрицы (объем работы поэлементных операций)
+  long long Size() const { return static_cast<long long>(rows_) * cols_; }
+
+  // Шаг строки в элементах, кратный kAlignment
+  static int AlignedStride(int cols);
+
+  // Выделяет из allocator выровненный буфер из count элементов,
+  // заполненный нулями
+  static T* AllocateBuffer(S21Allocator* allocator, std::size_t count);
+
+  // Возвращает в allocator буфер из count элементов, выделенный
+  // AllocateBuffer
+  static void DeallocateBuffer(S21Allocator* allocator, T* buffer,
+                               std::size_t count);
+
+  // Вызывает body для блоков строк [begin, end), большие матрицы — в
+  // нескольких потоках
+  void ParallelRows(const std::function<void(int, int)>& body) const;
+
+  // Вычисляет выражение того же размера прямо в буфер матрицы. Каждый
+  // элемент результата зависит только от элементов операндов с теми же
+  // индексами, поэтому операнды могут ссылаться на саму матрицу
+  template <typename E>
+  void AssignExpr(const E& expr) {
+    static_assert(std::is_same_v<typename E::value_type, T>,
+                  "Expression and matrix element types must match");
+    Touch();
+    T* dst = matrix_;
+    const int stride = stride_;
+    ParallelRows([&expr, dst, stride](int begin, int end) {
+      S21EvalRows(expr, begin, end, dst, stride);
+    });
+  }
 
  public:
   // Базовый конструктор
-  S21Matrix();
+  S21BasicMatrix();
 
   // Параметризированный конструктор
-  S21Matrix(int rows, int cols);
+  S21BasicMatrix(int rows, int cols);
 
   // Конструктор копирования
-  S21Matrix(const S21Matrix& other);
+  S21BasicMatrix(const S21BasicMatrix& other);
 
   // Конструктор переноса
-  S21Matrix(S21Matrix&& other);
+  S21BasicMatrix(S21BasicMatrix&& other);
+
+  // Матрица над отображенным файлом (см. MapFile) за O(1): отображение
+  // переходит к матрице и снимается вместе с ее буфером, элементы не
+  // копируются. Отображение частное, поэтому запись в матрицу копирует
+  // затронутые страницы и не попадает в файл; отображение только для
+  // чтения получает право записи на тех же условиях. Матрица включает
+  // копирование при записи (EnableCopyOnWrite), так что и ее копии
+  // стоят O(1). Если шаг строки в файле отличается от шага матрицы,
+  // строки копируются в собственный буфер
+  explicit S21BasicMatrix(S21BasicMappedMatrix<T>&& mapped);
+
+  // Конструктор из ленивого выражения: вся цепочка считается одним
+  // проходом (см. s21_matrix_expr.h)
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr)
+      : S21BasicMatrix(expr.Self().GetRows(), expr.Self().GetCols()) {
+    AssignExpr(expr.Self());
+  }
 
   // Деструктор
-  ~S21Matrix();
+  ~S21BasicMatrix();
 
   // methods
   // Проверяет матрицы на равенство между собой
-  bool EqMatrix(const S21Matrix& other);
+  bool EqMatrix(const S21BasicMatrix& other);
 
   // Прибавляет вторую матрицу к текущей
-  void SumMatrix(const S21Matrix& other);
+  void SumMatrix(const S21BasicMatrix& other);
 
   // Вычитает из текущей матрицы другую
-  void SubMatrix(const S21Matrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
 
   // Умножает текущую матрицу на число
-  void MulNumber(const double num);
+  void MulNumber(const T num);
 
-  // Умножает текущую матрицу на вторую
-  void MulMatrix(const S21Matrix& other);
+  // Умножает текущую матрицу на вторую. По умолчанию алгоритм выбирается
+  // по размеру; его можно задать явно (см. s21_matrix_gemm.h)
+  void MulMatrix(const S21BasicMatrix& other,
+                 S21MulAlgorithm algorithm = S21MulAlgorithm::kAuto);
 
-  // Создает новую транспонированную матрицу из текущей и возвращает ее
-  S21Matrix Transpose();
+  // Создает новую транспонированную матрицу из текущей и возвращает ее.
+  // Копирует рекурсивными блоками (см. s21_matrix_transpose.h)
+  S21BasicMatrix Transpose();
+
+  // Транспонирует матрицу на месте. Квадратная матрица сохраняет свой
+  // буфер, для прямоугольной выделяется новый
+  void TransposeInPlace();
+
+  // Ленивая транспонированная матрица: вид без копирования элементов
+  // (см. s21_matrix_view.h). Произведения видов и матриц передают
+  // транспонирование прямо в S21Gemm, поэтому A.TransposeView() * B не
+  // создает A^T. Вид действителен, пока матрица жива и не меняет размер
+  S21BasicMatrixView<const T> TransposeView() const;
 
   // Вычисляет матрицу алгебраических дополнений текущей матрицы и возвращает ее
-  S21Matrix CalcComplements();
+  S21BasicMatrix CalcComplements();
 
   // Вычисляет и возвращает определитель текущей матрицы
-  double Determinant();
+  T Determinant();
+
+  // Вычисляет и возвращает обратную матрицу. Матрица порядка больше 4 с
+  // плавающей точкой обращается через LU-разложение и считается
+  // вырожденной, если наименьший по модулю ведущий элемент не больше
+  // n * eps * max|a_ij|: такая матрица вырождена с точностью до
+  // округления. Бросает std::invalid_argument для неквадратной и
+  // вырожденной матрицы
+  S21BasicMatrix InverseMatrix();
+
+  // Решает A * X = B для всех столбцов B или для вектора b: квадратную
+  // систему через LU-разложение, переопределенную (строк больше, чем
+  // столбцов) — в смысле наименьших квадратов через QR. Разложение
+  // считается заново при каждом вызове; чтобы решать с одной матрицей
+  // много правых частей за O(n^2) каждую, сохраните S21BasicLU,
+  // S21BasicCholesky или S21BasicQR (s21_matrix_solve.h). Бросает
+  // std::invalid_argument для целочисленной матрицы, несовпадения
+  // размеров, вырожденной или неполного ранга матрицы
+  S21BasicMatrix Solve(const S21BasicMatrix& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+
+  // Степень A^k квадратной матрицы за O(log k) умножений двоичным
+  // возведением. Промежуточные произведения пишутся в два буфера по
+  // очереди, а рабочая память Штрассена (для больших n) выделяется один
+  // раз, поэтому число выделений памяти не зависит от k. A^0 = E,
+  // отрицательная степень — степень обратной матрицы. Бросает
+  // std::invalid_argument для неквадратной матрицы и (при k < 0) для
+  // необратимой
+  S21BasicMatrix Pow(int k) const;
 
-  //Вычисляет и возвращает обратную матрицу
-  S21Matrix InverseMatrix();
+  // Матричная экспонента e^A методом масштабирования и возведения в
+  // квадрат: A делится на 2^s так, что ||A / 2^s|| <= 1/2, экспонента
+  // приближается диагональной аппроксимацией Паде, а результат s раз
+  // возводится в квадрат. Бросает std::invalid_argument для
+  // неквадратной, целочисленной матрицы или матрицы с бесконечными или
+  // NaN элементами
+  S21BasicMatrix Expm() const;
+
+  // Норма по строкам max_i sum_j |a_ij|; для целых матриц точная
+  T Norm() const;
+
+  // Кэш производных величин. Включенный кэш хранит определитель,
+  // LU-разложение, обратную матрицу и норму, посчитанные для текущего
+  // содержимого: повторный Determinant или Norm стоит O(1),
+  // InverseMatrix — копию готового результата, Solve — O(n^2) на
+  // столбец. Любое изменение через методы матрицы (неконстантные
+  // operator(), data() и row(), SetRows, SetCols, присваивания и
+  // арифметика на месте) увеличивает номер версии, и кэш пересчитывается
+  // при следующем запросе. Запись через указатель или вид, полученные до
+  // запроса, матрица не видит: после нее нужен InvalidateCache().
+  // Копия матрицы начинается с выключенным кэшем, присваивание
+  // настройку не меняет.
+  // Кэш заполняется и константными методами, поэтому матрицу с
+  // включенным кэшем нельзя опрашивать из нескольких потоков сразу
+  void EnableCache(bool enabled = true);
+  bool IsCacheEnabled() const;
+  void InvalidateCache();
+
+  // Номер версии содержимого (см. EnableCache)
+  unsigned long long GetVersion() const;
+
+  // Режим копирования при записи. Копия такой матрицы не копирует
+  // элементы, а разделяет с ней буфер со счетчиком ссылок и наследует
+  // режим; буфер копируется при первой записи в одну из копий (через
+  // неконстантные operator(), data(), row() или любой изменяющий метод).
+  // Присваивание настройку получателя не меняет: в матрицу с режимом
+  // присваивание другой такой матрицы разделяет буфер, в остальных
+  // случаях элементы копируются. Выключение режима отделяет буфер,
+  // если он разделен.
+  // Счетчик атомарный: копии можно читать, копировать и уничтожать из
+  // разных потоков одновременно. Запись через указатель или вид,
+  // полученные до копирования, попадает во все копии
+  void EnableCopyOnWrite(bool enabled = true);
+  bool IsCopyOnWrite() const;
+
+  // Буфер разделен с другими копиями
+  bool IsShared() const;
 
   // Accessor and Mutator
 
@@ -71,22 +349,160 @@ class S21Matrix {
   void SetRows(int rows);  // Mutator для поля rows_
   int GetCols() const;     // Accessor для поля cols_
   void SetCols(int cols);  // Mutator для поля cols_
+  int GetStride() const;   // Accessor для поля stride_
+
+  // Прямой доступ к хранилищу
+
+  // Указатель на первый элемент; строка i начинается с data() + i * stride
+  T* data();
+  const T* data() const;
+
+  // Строка i в виде непрерывного диапазона из cols_ элементов
+  S21Span<T> row(int i);
+  S21Span<const T> row(int i) const;
+
+  // Двоичный файл матрицы (формат описан в s21_matrix_file.h)
+
+  // Записывает матрицу в файл path. Бросает std::runtime_error при
+  // ошибке записи
+  void SaveFile(const std::string& path) const;
+
+  // Отображает файл path в память за O(1): страницы читаются с диска при
+  // первом обращении. Бросает std::runtime_error, если файл нельзя
+  // открыть или он не содержит матрицу с элементами типа T. Результат
+  // дает виды для функций с указателем и шагом; полноценную матрицу над
+  // тем же отображением, тоже за O(1), дает
+  // S21BasicMatrix(MapFile(path))
+  static S21BasicMappedMatrix<T> MapFile(
+      const std::string& path, S21MapMode mode = S21MapMode::kReadOnly);
 
   // operators
+  // Операторы +, - и умножение на число объявлены в s21_matrix_expr.h и
+  // возвращают ленивые выражения
+
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other);
+  S21BasicMatrix operator*(const S21BasicMatrix& other);
+  bool operator==(const S21BasicMatrix& other);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(T num);
+
+  // Присваивание выражения; при совпадении размеров буфер переиспользуется
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr) {
+    const E& e = expr.Self();
+    if (matrix_ == nullptr || rows_ != e.GetRows() || cols_ != e.GetCols()) {
+      return *this = S21BasicMatrix(e);
+    }
+    AssignExpr(e);
+    return *this;
+  }
+
+  template <typename E>
+  bool operator==(const S21MatrixExpr<E>& expr) {
+    return EqMatrix(S21BasicMatrix(expr.Self()));
+  }
 
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other);
-  S21Matrix operator*(const double num);
-  friend S21Matrix operator*(const double num, S21Matrix& matrix);
-  S21Matrix operator*(const S21Matrix& other);
-  bool operator==(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(double num);
-  double& operator()(int i, int j);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr) {
+    return *this = *this + expr;
+  }
+
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr) {
+    return *this = *this - expr;
+  }
+  T& operator()(int i, int j);
+  const T& operator()(int i, int j) const;
 };
 
-#endif  // S21_MATRIX_OOP_H
\ No newline at end of file
+// Основной тип библиотеки — матрица double
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+using S21MatrixI = S21BasicMatrix<int>;
+using S21MatrixI64 = S21BasicMatrix<std::int64_t>;
+
+// Члены шаблона определены в s21_matrix_oop.cpp и собраны для этих типов
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<int>;
+extern template class S21BasicMatrix<std::int64_t>;
+
+// Произведение и сравнение выражений: операнды вычисляются в матрицы
+template <typename L, typename R>
+S21BasicMatrix<typename L::value_type> operator*(
+    const S21MatrixExpr<L>& left, const S21MatrixExpr<R>& right) {
+  using Matrix = S21BasicMatrix<typename L::value_type>;
+  return Matrix(left.Self()) * Matrix(right.Self());
+}
+
+template <typename L, typename R>
+bool operator==(const S21MatrixExpr<L>& left, const S21MatrixExpr<R>& right) {
+  using Matrix = S21BasicMatrix<typename L::value_type>;
+  return Matrix(left.Self()) == Matrix(right.Self());
+}
+
+// Операторы с временной матрицей-операндом считают результат прямо в ее
+// буфере и возвращают ее перемещением, не выделяя новую память. Так
+// цепочка вида a * b + c * 2.0 выделяет память только под произведение
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& left,
+                            S21BasicMatrix<T>&& right) {
+  left.SumMatrix(right);
+  return std::move(left);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& left,
+                            S21BasicMatrix<T>&& right) {
+  left.SubMatrix(right);
+  return std::move(left);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& matrix,
+                            const typename S21BasicMatrix<T>::value_type num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const typename S21BasicMatrix<T>::value_type num,
+                            S21BasicMatrix<T>&& matrix) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& left,
+                            const S21MatrixExpr<R>& right) {
+  left += right.Self();
+  return std::move(left);
+}
+
+template <typename L, typename T>
+S21BasicMatrix<T> operator+(const S21MatrixExpr<L>& left,
+                            S21BasicMatrix<T>&& right) {
+  right = left.Self() + right;
+  return std::move(right);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& left,
+                            const S21MatrixExpr<R>& right) {
+  left -= right.Self();
+  return std::move(left);
+}
+
+template <typename L, typename T>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<L>& left,
+                            S21BasicMatrix<T>&& right) {
+  right = left.Self() - right;
+  return std::move(right);
+}
+
+#endif  // S21_MATRIX_OOP_H
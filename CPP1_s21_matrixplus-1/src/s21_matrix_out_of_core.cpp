@@ -0,0 +1,417 @@
+#include "s21_matrix_out_of_core.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_file.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Строки плиток выравниваются на 64 байта, как строки матриц
+constexpr std::size_t kAlignment = 64;
+
+template <typename T>
+int AlignedLength(int cols) {
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  return (cols + per_line - 1) / per_line * per_line;
+}
+
+// Файл матрицы, из которого читаются и в который пишутся прямоугольные
+// плитки. Каждая строка плитки — один вызов pread или pwrite, поэтому
+// несколько потоков могут работать с одним файлом одновременно
+template <typename T>
+class TileFile {
+ public:
+  // Открывает существующий файл для чтения
+  explicit TileFile(const std::string& path)
+      : path_(path), fd_(open(path.c_str(), O_RDONLY)) {
+    if (fd_ < 0) {
+      throw Error(std::strerror(errno));
+    }
+    struct stat info;
+    S21MatrixFileHeader header;
+    if (fstat(fd_, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < sizeof(header)) {
+      close(fd_);
+      throw Error("File is too short for a matrix header");
+    }
+    try {
+      ReadBytes(&header, sizeof(header), 0);
+      S21CheckFileHeader<T>(header, static_cast<std::size_t>(info.st_size),
+                            path);
+    } catch (...) {
+      close(fd_);
+      throw;
+    }
+    Init(header);
+  }
+
+  // Создает файл для матрицы rows x cols, заполненной нулями
+  TileFile(const std::string& path, int rows, int cols)
+      : path_(path),
+        fd_(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) {
+    if (fd_ < 0) {
+      throw Error(std::strerror(errno));
+    }
+    const S21MatrixFileHeader header = S21MakeFileHeader<T>(rows, cols);
+    const off_t size = static_cast<off_t>(header.data_offset) +
+                       static_cast<off_t>(header.rows) *
+                           static_cast<off_t>(header.stride) * sizeof(T);
+    try {
+      WriteBytes(&header, sizeof(header), 0);
+      if (ftruncate(fd_, size) != 0) {
+        throw Error(std::strerror(errno));
+      }
+    } catch (...) {
+      close(fd_);
+      throw;
+    }
+    Init(header);
+  }
+
+  ~TileFile() { close(fd_); }
+
+  TileFile(const TileFile&) = delete;
+  TileFile& operator=(const TileFile&) = delete;
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+
+  // Открыт ли файл path (сравниваются устройство и номер inode, поэтому
+  // другой путь к тому же файлу тоже совпадает)
+  bool IsSameFile(const std::string& path) const {
+    struct stat own, other;
+    return fstat(fd_, &own) == 0 && stat(path.c_str(), &other) == 0 &&
+           own.st_dev == other.st_dev && own.st_ino == other.st_ino;
+  }
+
+  // Читает плитку rows x cols с элемента (row, col) в буфер с шагом ld
+  void Read(int row, int col, int rows, int cols, T* dst, int ld) const {
+    for (int r = 0; r < rows; ++r) {
+      ReadBytes(dst + static_cast<std::size_t>(r) * ld, sizeof(T) * cols,
+                Offset(row + r, col));
+    }
+  }
+
+  // Записывает плитку rows x cols из буфера с шагом ld в элемент (row, col)
+  void Write(int row, int col, int rows, int cols, const T* src,
+             int ld) const {
+    for (int r = 0; r < rows; ++r) {
+      WriteBytes(src + static_cast<std::size_t>(r) * ld, sizeof(T) * cols,
+                 Offset(row + r, col));
+    }
+  }
+
+ private:
+  void Init(const S21MatrixFileHeader& header) {
+    rows_ = static_cast<int>(header.rows);
+    cols_ = static_cast<int>(header.cols);
+    stride_ = static_cast<off_t>(header.stride);
+    data_offset_ = static_cast<off_t>(header.data_offset);
+  }
+
+  off_t Offset(int row, int col) const {
+    return data_offset_ + (row * stride_ + col) * static_cast<off_t>(sizeof(T));
+  }
+
+  void ReadBytes(void* buffer, std::size_t bytes, off_t offset) const {
+    char* data = static_cast<char*>(buffer);
+    Repeat(bytes, offset, [this, data](std::size_t done, std::size_t left,
+                                       off_t at) {
+      return pread(fd_, data + done, left, at);
+    });
+  }
+
+  void WriteBytes(const void* buffer, std::size_t bytes, off_t offset) const {
+    const char* data = static_cast<const char*>(buffer);
+    Repeat(bytes, offset, [this, data](std::size_t done, std::size_t left,
+                                       off_t at) {
+      return pwrite(fd_, data + done, left, at);
+    });
+  }
+
+  // pread и pwrite могут передать меньше запрошенного: повторяем до конца
+  template <typename Call>
+  void Repeat(std::size_t bytes, off_t offset, Call call) const {
+    std::size_t done = 0;
+    while (done < bytes) {
+      const ssize_t result = call(done, bytes - done, offset + done);
+      if (result < 0 && errno == EINTR) {
+        continue;
+      }
+      if (result <= 0) {
+        throw Error(result < 0 ? std::strerror(errno)
+                               : "Unexpected end of file");
+      }
+      done += static_cast<std::size_t>(result);
+    }
+  }
+
+  std::runtime_error Error(const std::string& what) const {
+    return std::runtime_error(what + ": " + path_);
+  }
+
+  std::string path_;
+  int fd_;
+  int rows_ = 0, cols_ = 0;
+  off_t stride_ = 0, data_offset_ = 0;
+};
+
+// Поток упреждающего чтения шагов 0 .. steps - 1 в два буфера: шаг s
+// читается в буфер s % 2, когда вычисления над шагом s - 2 закончены.
+// Поток создается один раз на все умножение
+class Prefetcher {
+ public:
+  Prefetcher(long long steps, std::function<void(long long)> load)
+      : steps_(steps), load_(std::move(load)), thread_([this] { Run(); }) {}
+
+  // Останавливает чтение, если вычисления прервались исключением
+  ~Prefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+  }
+
+  Prefetcher(const Prefetcher&) = delete;
+  Prefetcher& operator=(const Prefetcher&) = delete;
+
+  // Ждет, пока шаг s прочитан; пробрасывает ошибку чтения
+  void Acquire(long long s) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this, s] { return loaded_ > s || error_; });
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  // Освобождает буфер шага s для чтения шага s + 2
+  void Release(long long s) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      released_ = s + 1;
+    }
+    changed_.notify_all();
+  }
+
+ private:
+  void Run() {
+    for (long long s = 0; s < steps_; ++s) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this, s] { return stop_ || s < released_ + 2; });
+        if (stop_) {
+          return;
+        }
+      }
+      try {
+        load_(s);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+        changed_.notify_all();
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded_ = s + 1;
+      }
+      changed_.notify_all();
+    }
+  }
+
+  const long long steps_;
+  const std::function<void(long long)> load_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  long long loaded_ = 0;    // Сколько шагов прочитано
+  long long released_ = 0;  // Сколько шагов посчитано
+  bool stop_ = false;
+  std::exception_ptr error_;
+  std::thread thread_;  // Последним: поток видит готовые поля
+};
+
+// Память буферов упаковки S21GemmBlocked для произведения плиток
+// rows x depth и depth x cols: каждый поток общего пула упаковывает блок A
+// mc x kc и блок B kc x nc. Для типов без векторных ядер S21Gemm считает
+// простым циклом и не упаковывает
+template <typename T>
+std::size_t PackingBytes(int rows, int cols, int depth) {
+  if constexpr (kS21HasKernels<T>) {
+    const S21KernelTable<T>& kernels = S21GetKernels<T>();
+    const S21GemmBlocking blocking = S21GetGemmBlocking();
+    auto round_up = [](int value, int step) {
+      return static_cast<std::size_t>((value + step - 1) / step * step);
+    };
+    const std::size_t mc =
+        round_up(std::min(blocking.mc, rows), kernels.gemm_mr);
+    const std::size_t nc =
+        round_up(std::min(blocking.nc, cols), kernels.gemm_nr);
+    const std::size_t kc = std::min(blocking.kc, depth);
+    return sizeof(T) * static_cast<std::size_t>(S21GetThreadCount()) *
+           (mc + nc) * kc;
+  } else {
+    static_cast<void>(rows);
+    static_cast<void>(cols);
+    static_cast<void>(depth);
+    return 0;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+S21OutOfCoreStats S21MultiplyFiles(const std::string& a_path,
+                                   const std::string& b_path,
+                                   const std::string& c_path,
+                                   std::size_t memory_budget) {
+  const TileFile<T> a(a_path);
+  const TileFile<T> b(b_path);
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
+  const int m = a.GetRows();
+  const int n = b.GetCols();
+  const int k = a.GetCols();
+
+  if (a.IsSameFile(c_path) || b.IsSameFile(c_path)) {
+    throw std::invalid_argument(
+        "The result file must differ from the operand files");
+  }
+
+  // Квадратная плитка t x t: плитка C и две пары плиток A и B — 5 t^2
+  // элементов, плюс буферы упаковки. t кратно строке кэша; начинаем с
+  // оценки без упаковки и уменьшаем, пока все не уместится в бюджет
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  auto plan = [&](int t) {
+    S21OutOfCoreStats stats{};
+    stats.tile_rows = std::min(t, m);
+    stats.tile_cols = std::min(t, n);
+    stats.tile_depth = std::min(t, k);
+    const std::size_t a_tile = static_cast<std::size_t>(stats.tile_rows) *
+                               AlignedLength<T>(stats.tile_depth);
+    const std::size_t b_tile = static_cast<std::size_t>(stats.tile_depth) *
+                               AlignedLength<T>(stats.tile_cols);
+    const std::size_t c_tile = static_cast<std::size_t>(stats.tile_rows) *
+                               AlignedLength<T>(stats.tile_cols);
+    stats.buffer_bytes = sizeof(T) * (c_tile + 2 * (a_tile + b_tile));
+    stats.workspace_bytes =
+        PackingBytes<T>(stats.tile_rows, stats.tile_cols, stats.tile_depth);
+    return stats;
+  };
+  int t = static_cast<int>(std::sqrt(memory_budget / (5.0 * sizeof(T)))) /
+          per_line * per_line;
+  S21OutOfCoreStats stats = plan(t);
+  while (t > 0 && stats.buffer_bytes + stats.workspace_bytes > memory_budget) {
+    t -= per_line;
+    stats = plan(t);
+  }
+  if (t <= 0) {
+    throw std::invalid_argument("Memory budget is too small for a tile");
+  }
+  const int lda = AlignedLength<T>(stats.tile_depth);
+  const int ldb = AlignedLength<T>(stats.tile_cols);
+  const int ldc = ldb;
+  std::vector<T> c_tile(static_cast<std::size_t>(stats.tile_rows) * ldc);
+  std::vector<T> a_tiles[2];
+  std::vector<T> b_tiles[2];
+  for (int buffer = 0; buffer < 2; ++buffer) {
+    a_tiles[buffer].resize(static_cast<std::size_t>(stats.tile_rows) * lda);
+    b_tiles[buffer].resize(static_cast<std::size_t>(stats.tile_depth) * ldb);
+  }
+
+  const TileFile<T> c(c_path, m, n);
+  const long long row_tiles = (m + stats.tile_rows - 1) / stats.tile_rows;
+  const long long col_tiles = (n + stats.tile_cols - 1) / stats.tile_cols;
+  const long long depth_tiles = (k + stats.tile_depth - 1) / stats.tile_depth;
+  const long long steps = row_tiles * col_tiles * depth_tiles;
+
+  // Шаг s — произведение плиток A(i, p) и B(p, j); p меняется быстрее
+  // всех, и плитка C(i, j) накапливается за depth_tiles шагов подряд
+  struct Tile {
+    int row, col, depth;     // Первая строка C, первый столбец C, первый k
+    int rows, cols, length;  // Размеры плиток
+    bool first, last;        // Первый и последний шаг по k
+  };
+  auto tile_of = [&](long long s) {
+    const long long p = s % depth_tiles;
+    const long long j = s / depth_tiles % col_tiles;
+    const long long i = s / depth_tiles / col_tiles;
+    Tile tile;
+    tile.row = static_cast<int>(i * stats.tile_rows);
+    tile.col = static_cast<int>(j * stats.tile_cols);
+    tile.depth = static_cast<int>(p * stats.tile_depth);
+    tile.rows = std::min(stats.tile_rows, m - tile.row);
+    tile.cols = std::min(stats.tile_cols, n - tile.col);
+    tile.length = std::min(stats.tile_depth, k - tile.depth);
+    tile.first = p == 0;
+    tile.last = p == depth_tiles - 1;
+    return tile;
+  };
+  auto load = [&](long long s) {
+    const Tile tile = tile_of(s);
+    a.Read(tile.row, tile.depth, tile.rows, tile.length,
+           a_tiles[s % 2].data(), lda);
+    b.Read(tile.depth, tile.col, tile.length, tile.cols,
+           b_tiles[s % 2].data(), ldb);
+  };
+
+  // Пока считается шаг s, поток чтения заполняет другой буфер шагом s + 1
+  Prefetcher prefetcher(steps, load);
+  for (long long s = 0; s < steps; ++s) {
+    prefetcher.Acquire(s);
+    const Tile tile = tile_of(s);
+    S21Gemm(tile.rows, tile.cols, tile.length, a_tiles[s % 2].data(), lda,
+            b_tiles[s % 2].data(), ldb, c_tile.data(), ldc, !tile.first,
+            S21MulAlgorithm::kClassic);
+    prefetcher.Release(s);
+    if (tile.last) {
+      c.Write(tile.row, tile.col, tile.rows, tile.cols, c_tile.data(), ldc);
+    }
+  }
+  stats.tiles_read = 2 * steps;
+  return stats;
+}
+
+template S21OutOfCoreStats S21MultiplyFiles<float>(const std::string&,
+                                                   const std::string&,
+                                                   const std::string&,
+                                                   std::size_t);
+template S21OutOfCoreStats S21MultiplyFiles<double>(const std::string&,
+                                                    const std::string&,
+                                                    const std::string&,
+                                                    std::size_t);
+template S21OutOfCoreStats S21MultiplyFiles<long double>(const std::string&,
+                                                         const std::string&,
+                                                         const std::string&,
+                                                         std::size_t);
+template S21OutOfCoreStats S21MultiplyFiles<int>(const std::string&,
+                                                 const std::string&,
+                                                 const std::string&,
+                                                 std::size_t);
+template S21OutOfCoreStats S21MultiplyFiles<std::int64_t>(const std::string&,
+                                                          const std::string&,
+                                                          const std::string&,
+                                                          std::size_t);
@@ -0,0 +1,49 @@
+#ifndef S21_MATRIX_OUT_OF_CORE_H
+#define S21_MATRIX_OUT_OF_CORE_H
+
+// Умножение матриц, которые не помещаются в память. Операнды и результат
+// — файлы в формате s21_matrix_file.h. Результат C = A * B считается по
+// плиткам: для каждой плитки C в памяти суммируются произведения
+// соответствующих плиток A и B обычным блочным умножением (S21Gemm),
+// затем плитка записывается в файл. Пока считается одно произведение,
+// поток упреждающего чтения, созданный один раз на умножение, читает
+// следующую пару плиток во второй буфер, поэтому ввод-вывод перекрывается
+// с вычислениями.
+//
+// Одновременно в памяти находятся плитка C, две пары плиток A и B
+// (текущая и читаемая) и буферы упаковки блочного умножения — по блоку A
+// mc x kc и блоку B kc x nc на каждый поток общего пула. Размер плиток
+// подбирается так, чтобы все это уместилось в заданный бюджет. Плитки
+// умножаются классическим алгоритмом: рабочая память Штрассена в бюджет
+// не входит.
+
+#include <cstddef>
+#include <string>
+
+// Параметры выполненного умножения
+struct S21OutOfCoreStats {
+  // Размеры плиток: C — tile_rows x tile_cols, A — tile_rows x tile_depth,
+  // B — tile_depth x tile_cols
+  int tile_rows;
+  int tile_cols;
+  int tile_depth;
+  // Сколько байт заняли буферы плиток
+  std::size_t buffer_bytes;
+  // Сколько байт нужно буферам упаковки S21GemmBlocked во всех потоках
+  std::size_t workspace_bytes;
+  // Сколько плиток прочитано из файлов операндов
+  long long tiles_read;
+};
+
+// Записывает в файл c_path произведение матриц из файлов a_path и b_path,
+// держа в памяти не больше memory_budget байт буферов плиток и упаковки.
+// Бросает std::invalid_argument при несогласованных размерах, слишком
+// малом бюджете или если c_path — тот же файл, что a_path или b_path, и
+// std::runtime_error при ошибках ввода-вывода
+template <typename T>
+S21OutOfCoreStats S21MultiplyFiles(const std::string& a_path,
+                                   const std::string& b_path,
+                                   const std::string& c_path,
+                                   std::size_t memory_budget);
+
+#endif  // S21_MATRIX_OUT_OF_CORE_H
@@ -0,0 +1,408 @@
+#include "s21_matrix_solve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Элемент (i, j) матрицы op(A)
+template <typename T>
+T At(const T* a, int lda, bool trans, int i, int j) {
+  return trans ? a[static_cast<std::size_t>(j) * lda + i]
+               : a[static_cast<std::size_t>(i) * lda + j];
+}
+
+// Один столбец x (непрерывный). Строки A читаются подряд в обоих случаях:
+// для op(A) = A — скалярное произведение строки A с найденной частью x,
+// для op(A) = A^T строка A — это столбец op(A), и найденный x_j сразу
+// вычитается из остальных неизвестных
+template <typename T>
+void SolveVector(bool forward, bool trans, bool unit_diagonal, int n,
+                 const T* a, int lda, T* x) {
+  for (int step = 0; step < n; ++step) {
+    const int i = forward ? step : n - 1 - step;
+    const T* row = a + static_cast<std::size_t>(i) * lda;
+    if (!trans) {
+      // Известные неизвестные: [0, i) при прямом ходе, (i, n) при обратном
+      const int begin = forward ? 0 : i + 1;
+      const int length = forward ? i : n - i - 1;
+      x[i] -= S21KernelDot(length, row + begin, x + begin);
+      if (!unit_diagonal) {
+        x[i] /= row[i];
+      }
+    } else {
+      if (!unit_diagonal) {
+        x[i] /= row[i];
+      }
+      if (forward) {
+        S21KernelAxpy(n - i - 1, -x[i], row + i + 1, x + i + 1);
+      } else {
+        S21KernelAxpy(i, -x[i], row, x);
+      }
+    }
+  }
+}
+
+// Диагональный блок [begin, end): строки B обновляются axpy по m элементам
+template <typename T>
+void SolveDiagonalBlock(bool forward, bool trans, bool unit_diagonal,
+                        int begin, int end, int m, const T* a, int lda, T* b,
+                        int ldb) {
+  for (int step = begin; step < end; ++step) {
+    const int i = forward ? step : begin + end - 1 - step;
+    T* b_i = b + static_cast<std::size_t>(i) * ldb;
+    const int from = forward ? begin : i + 1;
+    const int to = forward ? i : end;
+    for (int j = from; j < to; ++j) {
+      const T factor = At(a, lda, trans, i, j);
+      if (factor != 0) {
+        S21KernelAxpy(m, -factor, b + static_cast<std::size_t>(j) * ldb, b_i);
+      }
+    }
+    if (!unit_diagonal) {
+      S21KernelScale(m, b_i, T(1) / At(a, lda, trans, i, i));
+    }
+  }
+}
+
+// B[rows) -= op(A)[rows, block) * B[block): вклад решенного блока в
+// остальные строки. S21Gemm только прибавляет, поэтому решенный блок на
+// время умножения меняет знак (смена знака точна)
+template <typename T>
+void UpdateRows(bool trans, int row, int rows, int block, int block_rows,
+                int m, const T* a, int lda, T* b, int ldb) {
+  if (rows == 0) {
+    return;
+  }
+  T* solved = b + static_cast<std::size_t>(block) * ldb;
+  for (int i = 0; i < block_rows; ++i) {
+    S21KernelScale(m, solved + static_cast<std::size_t>(i) * ldb, T(-1));
+  }
+  // op(A)[row, block] для транспонированной A — элемент A(block, row)
+  const T* a_block =
+      trans ? a + static_cast<std::size_t>(block) * lda + row
+            : a + static_cast<std::size_t>(row) * lda + block;
+  S21Gemm(trans ? S21Transpose::kYes : S21Transpose::kNo, S21Transpose::kNo,
+          rows, m, block_rows, a_block, lda, solved, ldb,
+          b + static_cast<std::size_t>(row) * ldb, ldb, true);
+  for (int i = 0; i < block_rows; ++i) {
+    S21KernelScale(m, solved + static_cast<std::size_t>(i) * ldb, T(-1));
+  }
+}
+
+void CheckRightHandSide(int rows, int order) {
+  if (rows != order) {
+    throw std::invalid_argument(
+        "The number of rows of the right-hand side must be equal to the "
+        "number of rows of the matrix.");
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21SolveTriangular(S21Triangle uplo, S21Transpose trans,
+                        bool unit_diagonal, int n, int m, const T* a, int lda,
+                        T* b, int ldb) {
+  const bool transposed = trans == S21Transpose::kYes;
+  // op(A) нижняя треугольная — решаем сверху вниз
+  const bool forward = (uplo == S21Triangle::kLower) != transposed;
+  if (n <= 0 || m <= 0) {
+    return;
+  }
+
+  if (m == 1) {
+    if (ldb == 1) {
+      SolveVector(forward, transposed, unit_diagonal, n, a, lda, b);
+      return;
+    }
+    std::vector<T> x(n);
+    for (int i = 0; i < n; ++i) {
+      x[i] = b[static_cast<std::size_t>(i) * ldb];
+    }
+    SolveVector(forward, transposed, unit_diagonal, n, a, lda, x.data());
+    for (int i = 0; i < n; ++i) {
+      b[static_cast<std::size_t>(i) * ldb] = x[i];
+    }
+    return;
+  }
+
+  const int blocks = (n + kS21SolveBlock - 1) / kS21SolveBlock;
+  for (int index = 0; index < blocks; ++index) {
+    const int block = forward ? index * kS21SolveBlock
+                              : (blocks - 1 - index) * kS21SolveBlock;
+    const int block_end = std::min(block + kS21SolveBlock, n);
+    SolveDiagonalBlock(forward, transposed, unit_diagonal, block, block_end,
+                       m, a, lda, b, ldb);
+    if (forward) {
+      UpdateRows(transposed, block_end, n - block_end, block,
+                 block_end - block, m, a, lda, b, ldb);
+    } else {
+      UpdateRows(transposed, 0, block, block, block_end - block, m, a, lda, b,
+                 ldb);
+    }
+  }
+}
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrix<T>& matrix)
+    : l_(matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument(
+        "Cholesky decomposition can only be calculated for square matrices.");
+  }
+
+  const int n = l_.GetRows();
+  const int ld = l_.GetStride();
+  T* a = l_.data();
+
+  // Столбец j: L_jj = sqrt(A_jj - L_j * L_j), затем
+  // L_ij = (A_ij - L_i * L_j) / L_jj, где L_i — первые j элементов строки
+  // i. Строки ниже диагонали считаются независимо и делятся между потоками
+  for (int j = 0; j < n; ++j) {
+    T* row_j = a + static_cast<std::size_t>(j) * ld;
+    const T diag = row_j[j] - S21KernelDot(j, row_j, row_j);
+    if (!(diag > 0)) {
+      throw std::invalid_argument(
+          "Cholesky decomposition requires a symmetric positive definite "
+          "matrix.");
+    }
+    row_j[j] = std::sqrt(diag);
+    const T inverse = T(1) / row_j[j];
+    const int tail = n - j - 1;
+    S21ParallelFor(tail, static_cast<long long>(tail) * j,
+                   [&](int begin, int end) {
+                     for (int i = j + 1 + begin; i < j + 1 + end; ++i) {
+                       T* row_i = a + static_cast<std::size_t>(i) * ld;
+                       row_i[j] = (row_i[j] - S21KernelDot(j, row_i, row_j)) *
+                                  inverse;
+                     }
+                   });
+  }
+  for (int i = 0; i < n; ++i) {
+    std::fill(a + static_cast<std::size_t>(i) * ld + i + 1,
+              a + static_cast<std::size_t>(i) * ld + n, T(0));
+  }
+}
+
+template <typename T>
+int S21BasicCholesky<T>::GetSize() const { return l_.GetRows(); }
+
+template <typename T>
+T S21BasicCholesky<T>::Determinant() const {
+  T product = 1;
+  for (int i = 0; i < l_.GetRows(); ++i) {
+    product *= l_(i, i);
+  }
+  return product * product;
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicCholesky<T>::GetL() const { return l_; }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  const int n = l_.GetRows();
+  CheckRightHandSide(b.GetRows(), n);
+  // L * Y = B, затем L^T * X = Y
+  S21BasicMatrix<T> x(b);
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kNo, false, n,
+                     x.GetCols(), l_.data(), l_.GetStride(), x.data(),
+                     x.GetStride());
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kYes, false, n,
+                     x.GetCols(), l_.data(), l_.GetStride(), x.data(),
+                     x.GetStride());
+  return x;
+}
+
+template <typename T>
+std::vector<T> S21BasicCholesky<T>::Solve(const std::vector<T>& b) const {
+  const int n = l_.GetRows();
+  CheckRightHandSide(static_cast<int>(b.size()), n);
+  std::vector<T> x(b);
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kNo, false, n, 1,
+                     l_.data(), l_.GetStride(), x.data(), 1);
+  S21SolveTriangular(S21Triangle::kLower, S21Transpose::kYes, false, n, 1,
+                     l_.data(), l_.GetStride(), x.data(), 1);
+  return x;
+}
+
+template <typename T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrix<T>& matrix)
+    : qr_(matrix), tau_(), full_rank_(true) {
+  if (matrix.GetRows() < matrix.GetCols()) {
+    throw std::invalid_argument(
+        "QR decomposition requires at least as many rows as columns.");
+  }
+
+  const int m = qr_.GetRows();
+  const int n = qr_.GetCols();
+  const int ld = qr_.GetStride();
+  T* a = qr_.data();
+  tau_.assign(n, T(0));
+  std::vector<T> w(n);
+
+  for (int k = 0; k < n; ++k) {
+    // Отражение H_k переводит столбец k ниже диагонали в beta * e_k:
+    // v = (1, x_{k+1} / (x_k - beta), ...), tau = (beta - x_k) / beta
+    T* row_k = a + static_cast<std::size_t>(k) * ld;
+    const T alpha = row_k[k];
+    T sigma = 0;
+    for (int i = k + 1; i < m; ++i) {
+      const T value = a[static_cast<std::size_t>(i) * ld + k];
+      sigma += value * value;
+    }
+    if (sigma == 0) {
+      // Столбец уже приведен: H_k = E
+      continue;
+    }
+    const T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+    const T tau = (beta - alpha) / beta;
+    const T scale = T(1) / (alpha - beta);
+    for (int i = k + 1; i < m; ++i) {
+      a[static_cast<std::size_t>(i) * ld + k] *= scale;
+    }
+    row_k[k] = beta;
+    tau_[k] = tau;
+
+    // Остальные столбцы: A -= tau * v * (v^T * A). Строка w = v^T * A
+    // собирается axpy по строкам, затем каждая строка обновляется своим
+    // axpy; строки независимы и делятся между потоками
+    const int tail = n - k - 1;
+    if (tail == 0) {
+      continue;
+    }
+    std::copy(row_k + k + 1, row_k + n, w.begin());
+    for (int i = k + 1; i < m; ++i) {
+      const T* row_i = a + static_cast<std::size_t>(i) * ld;
+      S21KernelAxpy(tail, row_i[k], row_i + k + 1, w.data());
+    }
+    S21KernelAxpy(tail, -tau, w.data(), row_k + k + 1);
+    S21ParallelFor(m - k - 1, static_cast<long long>(m - k - 1) * tail,
+                   [&](int begin, int end) {
+                     for (int i = k + 1 + begin; i < k + 1 + end; ++i) {
+                       T* row_i = a + static_cast<std::size_t>(i) * ld;
+                       S21KernelAxpy(tail, -tau * row_i[k], w.data(),
+                                     row_i + k + 1);
+                     }
+                   });
+  }
+
+  T largest = 0;
+  for (int k = 0; k < n; ++k) {
+    largest = std::max(largest, std::fabs(qr_(k, k)));
+  }
+  const T tolerance =
+      std::max(m, n) * std::numeric_limits<T>::epsilon() * largest;
+  for (int k = 0; k < n; ++k) {
+    if (!(std::fabs(qr_(k, k)) > tolerance)) {
+      full_rank_ = false;
+    }
+  }
+}
+
+template <typename T>
+int S21BasicQR<T>::GetRows() const { return qr_.GetRows(); }
+
+template <typename T>
+int S21BasicQR<T>::GetCols() const { return qr_.GetCols(); }
+
+template <typename T>
+bool S21BasicQR<T>::IsFullRank() const { return full_rank_; }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::GetR() const {
+  const int n = qr_.GetCols();
+  S21BasicMatrix<T> r(n, n);
+  for (int i = 0; i < n; ++i) {
+    std::copy(qr_.row(i).begin() + i, qr_.row(i).end(), r.row(i).begin() + i);
+  }
+  return r;
+}
+
+template <typename T>
+void S21BasicQR<T>::ApplyQt(int cols, T* x, int ldx) const {
+  // Q^T = H_{n-1} * ... * H_0: отражения применяются по порядку
+  const int m = qr_.GetRows();
+  const int n = qr_.GetCols();
+  std::vector<T> w(cols);
+  for (int k = 0; k < n; ++k) {
+    if (tau_[k] == 0) {
+      continue;
+    }
+    T* x_k = x + static_cast<std::size_t>(k) * ldx;
+    std::copy(x_k, x_k + cols, w.begin());
+    for (int i = k + 1; i < m; ++i) {
+      S21KernelAxpy(cols, qr_(i, k), x + static_cast<std::size_t>(i) * ldx,
+                    w.data());
+    }
+    S21KernelAxpy(cols, -tau_[k], w.data(), x_k);
+    for (int i = k + 1; i < m; ++i) {
+      S21KernelAxpy(cols, -tau_[k] * qr_(i, k), w.data(),
+                    x + static_cast<std::size_t>(i) * ldx);
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrix<T>& b) const {
+  const int n = qr_.GetCols();
+  CheckRightHandSide(b.GetRows(), qr_.GetRows());
+  if (!full_rank_) {
+    throw std::invalid_argument(
+        "Least squares problem cannot be solved for rank-deficient "
+        "matrices.");
+  }
+  // R * X = (Q^T * B)[0, n)
+  S21BasicMatrix<T> work(b);
+  const int cols = work.GetCols();
+  ApplyQt(cols, work.data(), work.GetStride());
+  S21SolveTriangular(S21Triangle::kUpper, S21Transpose::kNo, false, n, cols,
+                     qr_.data(), qr_.GetStride(), work.data(),
+                     work.GetStride());
+  if (work.GetRows() == n) {
+    return work;
+  }
+  S21BasicMatrix<T> x(n, cols);
+  for (int i = 0; i < n; ++i) {
+    std::copy(work.row(i).begin(), work.row(i).end(), x.row(i).begin());
+  }
+  return x;
+}
+
+template <typename T>
+std::vector<T> S21BasicQR<T>::Solve(const std::vector<T>& b) const {
+  const int n = qr_.GetCols();
+  CheckRightHandSide(static_cast<int>(b.size()), qr_.GetRows());
+  if (!full_rank_) {
+    throw std::invalid_argument(
+        "Least squares problem cannot be solved for rank-deficient "
+        "matrices.");
+  }
+  std::vector<T> x(b);
+  ApplyQt(1, x.data(), 1);
+  S21SolveTriangular(S21Triangle::kUpper, S21Transpose::kNo, false, n, 1,
+                     qr_.data(), qr_.GetStride(), x.data(), 1);
+  x.resize(n);
+  return x;
+}
+
+template void S21SolveTriangular(S21Triangle, S21Transpose, bool, int, int,
+                                 const float*, int, float*, int);
+template void S21SolveTriangular(S21Triangle, S21Transpose, bool, int, int,
+                                 const double*, int, double*, int);
+template void S21SolveTriangular(S21Triangle, S21Transpose, bool, int, int,
+                                 const long double*, int, long double*, int);
+
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
@@ -0,0 +1,123 @@
+#ifndef S21_MATRIX_SOLVE_H
+#define S21_MATRIX_SOLVE_H
+
+// Решение систем линейных уравнений A * X = B. Разложение матрицы
+// считается один раз за O(n^3) и хранится в объекте, а каждое решение с
+// новой правой частью стоит O(n^2) на столбец:
+//   S21BasicLU       — невырожденная квадратная матрица (s21_matrix_lu.h);
+//   S21BasicCholesky — симметричная положительно определенная матрица,
+//                      разложение вдвое дешевле LU;
+//   S21BasicQR       — матрица m x n, m >= n, полного ранга: решение в
+//                      смысле наименьших квадратов.
+// S21BasicMatrix::Solve сам выбирает LU или QR и подходит для
+// однократного решения; для многих правых частей выгоднее сохранить
+// разложение. Все три собраны для float, double и long double.
+
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+
+// Какой треугольник матрицы задает треугольную систему
+enum class S21Triangle { kLower, kUpper };
+
+// Число строк в блоке треугольного решения
+constexpr int kS21SolveBlock = 64;
+
+// Решает op(A) * X = B для треугольной матрицы A порядка n (шаг lda) и
+// правой части B из m столбцов (шаг ldb); X записывается на место B.
+// Читается только треугольник uplo; при unit_diagonal диагональ считается
+// единичной и тоже не читается.
+//
+// Для m > 1 система делится на блоки по kS21SolveBlock строк: диагональный
+// блок решается векторными ядрами по строкам B, а его вклад в остальные
+// строки вычитается одним умножением S21Gemm. Один столбец решается
+// скалярными произведениями строк A или axpy по ним — так A всегда
+// читается по строкам подряд
+template <typename T>
+void S21SolveTriangular(S21Triangle uplo, S21Transpose trans,
+                        bool unit_diagonal, int n, int m, const T* a, int lda,
+                        T* b, int ldb);
+
+// Разложение Холецкого A = L * L^T симметричной положительно определенной
+// матрицы
+template <typename T>
+class S21BasicCholesky {
+  static_assert(std::is_floating_point_v<T>,
+                "Cholesky decomposition requires floating-point elements");
+
+ public:
+  // Раскладывает матрицу, читая только ее нижний треугольник. Бросает
+  // std::invalid_argument для неквадратной матрицы и для матрицы, которая
+  // не является положительно определенной
+  explicit S21BasicCholesky(const S21BasicMatrix<T>& matrix);
+
+  int GetSize() const;
+
+  // Определитель: квадрат произведения диагонали L
+  T Determinant() const;
+
+  // L: нижняя треугольная, над диагональю нули
+  const S21BasicMatrix<T>& GetL() const;
+
+  // Решает A * X = B. Бросает std::invalid_argument, если число строк B
+  // не равно порядку матрицы
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> l_;
+};
+
+// QR-разложение A = Q * R отражениями Хаусхолдера: Q — ортогональная
+// m x m, R — верхняя треугольная n x n (под ней нули)
+template <typename T>
+class S21BasicQR {
+  static_assert(std::is_floating_point_v<T>,
+                "QR decomposition requires floating-point elements");
+
+ public:
+  // Раскладывает матрицу m x n. Бросает std::invalid_argument, если строк
+  // меньше, чем столбцов
+  explicit S21BasicQR(const S21BasicMatrix<T>& matrix);
+
+  int GetRows() const;
+  int GetCols() const;
+
+  // Все диагональные элементы R больше max(m, n) * epsilon(T) * max|R_ii|
+  bool IsFullRank() const;
+
+  // Верхняя треугольная R (n x n)
+  S21BasicMatrix<T> GetR() const;
+
+  // X (n столбцов B), минимизирующее ||A * X - B|| для каждого столбца;
+  // для квадратной A — точное решение. Бросает std::invalid_argument,
+  // если число строк B не равно m или ранг A неполный
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+
+ private:
+  // Применяет Q^T к m строкам x (по cols элементов, шаг ldx) на месте
+  void ApplyQt(int cols, T* x, int ldx) const;
+
+  // Выше диагонали и на ней — R, под диагональю — векторы отражений v
+  // (первый элемент v равен 1 и не хранится)
+  S21BasicMatrix<T> qr_;
+  // Отражение k: H_k = I - tau_[k] * v * v^T
+  std::vector<T> tau_;
+  bool full_rank_;
+};
+
+using S21Cholesky = S21BasicCholesky<double>;
+using S21QR = S21BasicQR<double>;
+
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+
+#endif  // S21_MATRIX_SOLVE_H
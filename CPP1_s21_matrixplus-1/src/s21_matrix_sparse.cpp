@@ -0,0 +1,372 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Number of rows and columns must be greater than zero");
+  }
+  offsets_.assign(Outer() + 1, 0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                              S21SparseFormat format,
+                                              T tolerance)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols(), format) {
+  auto keep = [tolerance](T value) {
+    return value > tolerance || value < -tolerance;
+  };
+  // Первый проход считает элементы, второй заполняет массивы
+  std::vector<int> counts(Outer(), 0);
+  for (int i = 0; i < rows_; ++i) {
+    const T* row = dense.row(i).data();
+    for (int j = 0; j < cols_; ++j) {
+      if (keep(row[j])) {
+        ++counts[format_ == S21SparseFormat::kCsr ? i : j];
+      }
+    }
+  }
+  std::partial_sum(counts.begin(), counts.end(), offsets_.begin() + 1);
+  indices_.resize(offsets_.back());
+  values_.resize(offsets_.back());
+  std::vector<int> next(offsets_.begin(), offsets_.end() - 1);
+  for (int i = 0; i < rows_; ++i) {
+    const T* row = dense.row(i).data();
+    for (int j = 0; j < cols_; ++j) {
+      if (keep(row[j])) {
+        const bool csr = format_ == S21SparseFormat::kCsr;
+        const int position = next[csr ? i : j]++;
+        indices_[position] = csr ? j : i;
+        values_[position] = row[j];
+      }
+    }
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::FromTriplets(
+    int rows, int cols, const std::vector<S21Triplet<T>>& triplets,
+    S21SparseFormat format) {
+  S21BasicSparseMatrix result(rows, cols, format);
+  const bool csr = format == S21SparseFormat::kCsr;
+  for (const S21Triplet<T>& t : triplets) {
+    if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Triplet indices are out of range");
+    }
+  }
+
+  // Сортировка подсчетом по внешнему индексу
+  std::vector<int> offsets(result.Outer() + 1, 0);
+  for (const S21Triplet<T>& t : triplets) {
+    ++offsets[(csr ? t.row : t.col) + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<int> order(triplets.size());
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+  for (int k = 0; k < static_cast<int>(triplets.size()); ++k) {
+    order[next[csr ? triplets[k].row : triplets[k].col]++] = k;
+  }
+
+  // Внутри строки (столбца) — по внутреннему индексу; одинаковые
+  // позиции складываются
+  result.indices_.reserve(triplets.size());
+  result.values_.reserve(triplets.size());
+  auto inner = [&](int k) { return csr ? triplets[k].col : triplets[k].row; };
+  for (int outer = 0; outer < result.Outer(); ++outer) {
+    auto first = order.begin() + offsets[outer];
+    auto last = order.begin() + offsets[outer + 1];
+    std::stable_sort(first, last,
+                     [&](int a, int b) { return inner(a) < inner(b); });
+    for (auto it = first; it != last;) {
+      const int index = inner(*it);
+      T sum = 0;
+      for (; it != last && inner(*it) == index; ++it) {
+        sum += triplets[*it].value;
+      }
+      if (sum != 0) {
+        result.indices_.push_back(index);
+        result.values_.push_back(sum);
+      }
+    }
+    result.offsets_[outer + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+S21SparseFormat S21BasicSparseMatrix<T>::GetFormat() const {
+  return format_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::NonZeros() const {
+  return static_cast<int>(values_.size());
+}
+
+template <typename T>
+const std::vector<int>& S21BasicSparseMatrix<T>::GetOffsets() const {
+  return offsets_;
+}
+
+template <typename T>
+const std::vector<int>& S21BasicSparseMatrix<T>::GetIndices() const {
+  return indices_;
+}
+
+template <typename T>
+const std::vector<T>& S21BasicSparseMatrix<T>::GetValues() const {
+  return values_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Outer() const {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const int outer = csr ? i : j;
+  const int inner = csr ? j : i;
+  const auto first = indices_.begin() + offsets_[outer];
+  const auto last = indices_.begin() + offsets_[outer + 1];
+  const auto it = std::lower_bound(first, last, inner);
+  return it != last && *it == inner ? values_[it - indices_.begin()] : T(0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) {
+    return *this;
+  }
+  // Перестановка подсчетом: элементы обходятся по возрастанию внешнего
+  // индекса, поэтому в новом формате внутренние индексы уже упорядочены
+  S21BasicSparseMatrix result(rows_, cols_, format);
+  for (int index : indices_) {
+    ++result.offsets_[index + 1];
+  }
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   result.offsets_.begin());
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (int outer = 0; outer < Outer(); ++outer) {
+    for (int k = offsets_[outer]; k < offsets_[outer + 1]; ++k) {
+      const int position = next[indices_[k]]++;
+      result.indices_[position] = outer;
+      result.values_[position] = values_[k];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const& {
+  return S21BasicSparseMatrix(*this).Transpose();
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() && {
+  S21BasicSparseMatrix result(std::move(*this));
+  std::swap(result.rows_, result.cols_);
+  result.format_ = result.format_ == S21SparseFormat::kCsr
+                       ? S21SparseFormat::kCsc
+                       : S21SparseFormat::kCsr;
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_);
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int outer = 0; outer < Outer(); ++outer) {
+    for (int k = offsets_[outer]; k < offsets_[outer + 1]; ++k) {
+      if (csr) {
+        result(outer, indices_[k]) = values_[k];
+      } else {
+        result(indices_[k], outer) = values_[k];
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+const S21BasicSparseMatrix<T>& S21BasicSparseMatrix<T>::AsCsr(
+    S21BasicSparseMatrix& storage) const {
+  if (format_ == S21SparseFormat::kCsr) {
+    return *this;
+  }
+  storage = ToFormat(S21SparseFormat::kCsr);
+  return storage;
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::Multiply(
+    const std::vector<T>& x) const {
+  if (static_cast<int>(x.size()) != cols_) {
+    throw std::invalid_argument(
+        "The vector size must be equal to the number of columns of the "
+        "matrix.");
+  }
+  std::vector<T> y(rows_, T(0));
+  if (format_ == S21SparseFormat::kCsr) {
+    // Строки независимы: каждая — скалярное произведение по своим
+    // ненулевым элементам
+    S21ParallelFor(rows_, NonZeros(), [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        T sum = 0;
+        for (int k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+          sum += values_[k] * x[indices_[k]];
+        }
+        y[i] = sum;
+      }
+    });
+  } else {
+    // Столбцы пишут в общие элементы y, поэтому обход последовательный
+    for (int j = 0; j < cols_; ++j) {
+      const T xj = x[j];
+      for (int k = offsets_[j]; k < offsets_[j + 1]; ++k) {
+        y[indices_[k]] += values_[k] * xj;
+      }
+    }
+  }
+  return y;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicMatrix<T>& dense) const {
+  if (cols_ != dense.GetRows()) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
+  const int n = dense.GetCols();
+  S21BasicMatrix<T> result(rows_, n);
+  const T* b = dense.data();
+  const int ldb = dense.GetStride();
+  T* c = result.data();
+  const int ldc = result.GetStride();
+  // Строка результата — сумма строк плотной матрицы с весами из строки
+  // разреженной: каждая строка B добавляется векторным ядром axpy
+  if (format_ == S21SparseFormat::kCsr) {
+    S21ParallelFor(rows_, static_cast<long long>(NonZeros()) * n,
+                   [&](int begin, int end) {
+                     for (int i = begin; i < end; ++i) {
+                       T* c_row = c + static_cast<std::size_t>(i) * ldc;
+                       for (int k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+                         S21KernelAxpy(
+                             n, values_[k],
+                             b + static_cast<std::size_t>(indices_[k]) * ldb,
+                             c_row);
+                       }
+                     }
+                   });
+  } else {
+    for (int j = 0; j < cols_; ++j) {
+      const T* b_row = b + static_cast<std::size_t>(j) * ldb;
+      for (int k = offsets_[j]; k < offsets_[j + 1]; ++k) {
+        S21KernelAxpy(n, values_[k], b_row,
+                      c + static_cast<std::size_t>(indices_[k]) * ldc);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicSparseMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
+  S21BasicSparseMatrix a_storage(1, 1);
+  S21BasicSparseMatrix b_storage(1, 1);
+  const S21BasicSparseMatrix& a = AsCsr(a_storage);
+  const S21BasicSparseMatrix& b = other.AsCsr(b_storage);
+
+  // Густавсон: строка i результата накапливается в плотном векторе
+  // accumulator, а marker помнит, какие столбцы в ней уже заняты
+  const int n = b.cols_;
+  S21BasicSparseMatrix result(rows_, n);
+  std::vector<T> accumulator(n, T(0));
+  std::vector<int> marker(n, -1);
+  std::vector<int> row_columns;
+  for (int i = 0; i < rows_; ++i) {
+    row_columns.clear();
+    for (int ka = a.offsets_[i]; ka < a.offsets_[i + 1]; ++ka) {
+      const int k = a.indices_[ka];
+      const T value = a.values_[ka];
+      for (int kb = b.offsets_[k]; kb < b.offsets_[k + 1]; ++kb) {
+        const int j = b.indices_[kb];
+        if (marker[j] != i) {
+          marker[j] = i;
+          accumulator[j] = 0;
+          row_columns.push_back(j);
+        }
+        accumulator[j] += value * b.values_[kb];
+      }
+    }
+    std::sort(row_columns.begin(), row_columns.end());
+    for (int j : row_columns) {
+      if (accumulator[j] != 0) {
+        result.indices_.push_back(j);
+        result.values_.push_back(accumulator[j]);
+      }
+    }
+    result.offsets_[i + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result.ToFormat(format_);
+}
+
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::operator*(
+    const std::vector<T>& x) const {
+  return Multiply(x);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T>& dense) const {
+  return Multiply(dense);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix& other) const {
+  return Multiply(other);
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
+template class S21BasicSparseMatrix<int>;
+template class S21BasicSparseMatrix<std::int64_t>;
@@ -0,0 +1,112 @@
+#ifndef S21_MATRIX_SPARSE_H
+#define S21_MATRIX_SPARSE_H
+
+// Разреженная матрица в сжатом формате по строкам (CSR) или по столбцам
+// (CSC). Хранятся только ненулевые элементы: для CSR offsets[i] и
+// offsets[i + 1] ограничивают в indices и values элементы строки i,
+// indices — номера их столбцов по возрастанию. CSC устроен так же, но
+// по столбцам. Память — O(rows + nnz) для CSR и O(cols + nnz) для CSC,
+// время произведений пропорционально числу ненулевых элементов.
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+enum class S21SparseFormat { kCsr, kCsc };
+
+// Элемент (row, col) со значением value для построения матрицы
+template <typename T>
+struct S21Triplet {
+  int row;
+  int col;
+  T value;
+};
+
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using value_type = T;
+
+  // Нулевая матрица rows x cols
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+
+  // Ненулевые элементы плотной матрицы; элементы с модулем не больше
+  // tolerance считаются нулями
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                S21SparseFormat format = S21SparseFormat::kCsr,
+                                T tolerance = 0);
+
+  // Строит матрицу из троек за O(nnz log nnz). Повторяющиеся позиции
+  // складываются, нулевые суммы не хранятся. Бросает std::out_of_range
+  // для индексов вне матрицы
+  static S21BasicSparseMatrix FromTriplets(
+      int rows, int cols, const std::vector<S21Triplet<T>>& triplets,
+      S21SparseFormat format = S21SparseFormat::kCsr);
+
+  int GetRows() const;
+  int GetCols() const;
+  S21SparseFormat GetFormat() const;
+
+  // Число хранимых элементов
+  int NonZeros() const;
+
+  // Сжатое представление (см. описание в начале файла)
+  const std::vector<int>& GetOffsets() const;
+  const std::vector<int>& GetIndices() const;
+  const std::vector<T>& GetValues() const;
+
+  // Элемент (i, j) двоичным поиском; отсутствующий равен нулю
+  T operator()(int i, int j) const;
+
+  // Та же матрица в другом формате за O(rows + cols + nnz)
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+
+  // Транспонированная матрица: CSR матрицы — это CSC транспонированной,
+  // поэтому элементы не переставляются. Для переменной три массива
+  // копируются за O(nnz); временная матрица отдает их перемещением за O(1)
+  S21BasicSparseMatrix Transpose() const&;
+  S21BasicSparseMatrix Transpose() &&;
+
+  // Плотная копия
+  S21BasicMatrix<T> ToDense() const;
+
+  // y = A * x. Для CSR строки результата считаются параллельно
+  std::vector<T> Multiply(const std::vector<T>& x) const;
+
+  // Разреженная на плотную: плотный результат. Для CSR строки результата
+  // считаются параллельно
+  S21BasicMatrix<T> Multiply(const S21BasicMatrix<T>& dense) const;
+
+  // Разреженная на разреженную (алгоритм Густавсона): результат в
+  // формате левого операнда
+  S21BasicSparseMatrix Multiply(const S21BasicSparseMatrix& other) const;
+
+  std::vector<T> operator*(const std::vector<T>& x) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& dense) const;
+  S21BasicSparseMatrix operator*(const S21BasicSparseMatrix& other) const;
+
+ private:
+  // Число строк для CSR или столбцов для CSC
+  int Outer() const;
+
+  // Та же матрица в CSR без копирования, если она уже в CSR
+  const S21BasicSparseMatrix& AsCsr(S21BasicSparseMatrix& storage) const;
+
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<T> values_;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+extern template class S21BasicSparseMatrix<int>;
+extern template class S21BasicSparseMatrix<std::int64_t>;
+
+#endif  // S21_MATRIX_SPARSE_H
@@ -0,0 +1,220 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+
+namespace {
+
+constexpr std::size_t kWorkspaceAlignment = 64;
+constexpr int kMinCrossover = 16;
+
+// Переход подобран по бенчмаркам BM_GemmStrassen: на блоках меньше 512
+// блочный алгоритм с AVX-512 быстрее, чем экономия одного умножения из
+// восьми. Выигрыш заметен уже с 2048 (около 30%), но автовыбор включается
+// с 4096, чтобы рост погрешности затрагивал только очень большие задачи
+std::atomic<int> g_crossover{512};
+std::atomic<int> g_threshold{4096};
+
+inline std::size_t Offset(int row, int ld) {
+  return static_cast<std::size_t>(row) * ld;
+}
+
+// Шаг строк временных блоков: кратен 16 элементам, то есть целому числу
+// кэш-линий и для double, и для float
+inline int PaddedLd(int cols) { return (cols + 15) / 16 * 16; }
+
+bool UseClassic(int m, int n, int k, int crossover) {
+  return std::min({m, n, k}) <= crossover;
+}
+
+// Рабочая память одного уровня: X (mh x max(kh, nh)) и Y (kh x nh)
+std::size_t LevelSize(int mh, int nh, int kh) {
+  return Offset(mh, PaddedLd(std::max(kh, nh))) + Offset(kh, PaddedLd(nh));
+}
+
+std::size_t WorkspaceSize(int m, int n, int k, int crossover) {
+  std::size_t total = 0;
+  while (!UseClassic(m, n, k, crossover)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    total += LevelSize(m, n, k);
+  }
+  return total;
+}
+
+// c = a + b; c может совпадать с a или b
+template <typename T>
+void AddBlocks(int m, int n, const T* a, int lda, const T* b, int ldb, T* c,
+               int ldc) {
+  const S21KernelTable<T>& kernels = S21GetKernels<T>();
+  for (int i = 0; i < m; ++i) {
+    const T* a_row = a + Offset(i, lda);
+    const T* b_row = b + Offset(i, ldb);
+    T* c_row = c + Offset(i, ldc);
+    if (c_row == b_row) {
+      kernels.add(n, c_row, a_row);
+    } else {
+      if (c_row != a_row) {
+        std::memcpy(c_row, a_row, n * sizeof(T));
+      }
+      kernels.add(n, c_row, b_row);
+    }
+  }
+}
+
+// c = a - b; c может совпадать с a или b
+template <typename T>
+void SubBlocks(int m, int n, const T* a, int lda, const T* b, int ldb, T* c,
+               int ldc) {
+  const S21KernelTable<T>& kernels = S21GetKernels<T>();
+  for (int i = 0; i < m; ++i) {
+    const T* a_row = a + Offset(i, lda);
+    const T* b_row = b + Offset(i, ldb);
+    T* c_row = c + Offset(i, ldc);
+    if (c_row == b_row) {
+      kernels.scale(n, c_row, T(-1));
+      kernels.add(n, c_row, a_row);
+    } else {
+      if (c_row != a_row) {
+        std::memcpy(c_row, a_row, n * sizeof(T));
+      }
+      kernels.sub(n, c_row, b_row);
+    }
+  }
+}
+
+template <typename T>
+void Strassen(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+              T* c, int ldc, T* workspace, int crossover) {
+  if (UseClassic(m, n, k, crossover)) {
+    S21GemmBlocked(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  const int mh = m / 2;
+  const int nh = n / 2;
+  const int kh = k / 2;
+
+  // Четверти операндов и результата
+  const T* a11 = a;
+  const T* a12 = a + kh;
+  const T* a21 = a + Offset(mh, lda);
+  const T* a22 = a21 + kh;
+  const T* b11 = b;
+  const T* b12 = b + nh;
+  const T* b21 = b + Offset(kh, ldb);
+  const T* b22 = b21 + nh;
+  T* c11 = c;
+  T* c12 = c + nh;
+  T* c21 = c + Offset(mh, ldc);
+  T* c22 = c21 + nh;
+
+  // Временные блоки уровня; остаток буфера достается следующим уровням
+  const int ldx = PaddedLd(std::max(kh, nh));
+  const int ldy = PaddedLd(nh);
+  T* x = workspace;
+  T* y = x + Offset(mh, ldx);
+  T* next = y + Offset(kh, ldy);
+
+  // Порядок вычислений с двумя временными блоками (Boyer, Dumas, Pernet,
+  // Zhou, "Memory efficient scheduling of Strassen-Winograd's matrix
+  // multiplication algorithm", 2009): промежуточные произведения хранятся
+  // в четвертях C
+  SubBlocks(mh, kh, a11, lda, a21, lda, x, ldx);  // S3 = A11 - A21
+  SubBlocks(kh, nh, b22, ldb, b12, ldb, y, ldy);  // T3 = B22 - B12
+  Strassen(mh, nh, kh, x, ldx, y, ldy, c21, ldc, next, crossover);  // P7
+  AddBlocks(mh, kh, a21, lda, a22, lda, x, ldx);  // S1 = A21 + A22
+  SubBlocks(kh, nh, b12, ldb, b11, ldb, y, ldy);  // T1 = B12 - B11
+  Strassen(mh, nh, kh, x, ldx, y, ldy, c22, ldc, next, crossover);  // P5
+  SubBlocks(mh, kh, x, ldx, a11, lda, x, ldx);  // S2 = S1 - A11
+  SubBlocks(kh, nh, b22, ldb, y, ldy, y, ldy);  // T2 = B22 - T1
+  Strassen(mh, nh, kh, x, ldx, y, ldy, c12, ldc, next, crossover);  // P6
+  SubBlocks(mh, kh, a12, lda, x, ldx, x, ldx);  // S4 = A12 - S2
+  Strassen(mh, nh, kh, x, ldx, b22, ldb, c11, ldc, next, crossover);  // P3
+  Strassen(mh, nh, kh, a11, lda, b11, ldb, x, ldx, next, crossover);  // P1
+  AddBlocks(mh, nh, x, ldx, c12, ldc, c12, ldc);      // U2 = P1 + P6
+  AddBlocks(mh, nh, c12, ldc, c21, ldc, c21, ldc);    // U3 = U2 + P7
+  AddBlocks(mh, nh, c12, ldc, c22, ldc, c12, ldc);    // U4 = U2 + P5
+  AddBlocks(mh, nh, c21, ldc, c22, ldc, c22, ldc);    // U7 = U3 + P5 = C22
+  AddBlocks(mh, nh, c12, ldc, c11, ldc, c12, ldc);    // U5 = U4 + P3 = C12
+  SubBlocks(kh, nh, y, ldy, b21, ldb, y, ldy);        // T4 = T2 - B21
+  Strassen(mh, nh, kh, a22, lda, y, ldy, c11, ldc, next, crossover);  // P4
+  SubBlocks(mh, nh, c21, ldc, c11, ldc, c21, ldc);    // U6 = U3 - P4 = C21
+  Strassen(mh, nh, kh, a12, lda, b21, ldb, c11, ldc, next, crossover);  // P2
+  AddBlocks(mh, nh, x, ldx, c11, ldc, c11, ldc);      // U1 = P1 + P2 = C11
+
+  // Нечетные размеры: досчитываем последний столбец A / строку B,
+  // последний столбец C и последнюю строку C классическим алгоритмом
+  if (k > 2 * kh) {
+    S21Gemm(2 * mh, 2 * nh, 1, a + (k - 1), lda, b + Offset(k - 1, ldb), ldb,
+            c, ldc, true);
+  }
+  if (n > 2 * nh) {
+    S21Gemm(m, 1, k, a, lda, b + (n - 1), ldb, c + (n - 1), ldc, false,
+            S21MulAlgorithm::kClassic);
+  }
+  if (m > 2 * mh) {
+    S21Gemm(1, 2 * nh, k, a + Offset(m - 1, lda), lda, b, ldb,
+            c + Offset(m - 1, ldc), ldc, false, S21MulAlgorithm::kClassic);
+  }
+}
+
+}  // namespace
+
+int S21GetStrassenCrossover() { return g_crossover; }
+
+void S21SetStrassenCrossover(int crossover) {
+  if (crossover < kMinCrossover) {
+    throw std::invalid_argument("Strassen crossover must be at least 16");
+  }
+  g_crossover = crossover;
+}
+
+int S21GetStrassenThreshold() { return g_threshold; }
+
+void S21SetStrassenThreshold(int threshold) { g_threshold = threshold; }
+
+std::size_t S21StrassenWorkspaceSize(int m, int n, int k) {
+  return WorkspaceSize(m, n, k, g_crossover);
+}
+
+template <typename T>
+void S21GemmStrassen(int m, int n, int k, const T* a, int lda, const T* b,
+                     int ldb, T* c, int ldc, T* workspace) {
+  if (m <= 0 || n <= 0 || k <= 0) {
+    return;
+  }
+  const int crossover = g_crossover;
+  const std::size_t size = WorkspaceSize(m, n, k, crossover);
+  if (size == 0) {
+    S21GemmBlocked(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  // Без буфера от вызывающего выделяем его один раз на все уровни
+  T* owned = nullptr;
+  if (workspace == nullptr) {
+    owned = static_cast<T*>(::operator new(
+        size * sizeof(T), std::align_val_t{kWorkspaceAlignment}));
+    workspace = owned;
+  }
+  try {
+    Strassen(m, n, k, a, lda, b, ldb, c, ldc, workspace, crossover);
+  } catch (...) {
+    ::operator delete(owned, std::align_val_t{kWorkspaceAlignment});
+    throw;
+  }
+  ::operator delete(owned, std::align_val_t{kWorkspaceAlignment});
+}
+
+template void S21GemmStrassen(int, int, int, const float*, int, const float*,
+                              int, float*, int, float*);
+template void S21GemmStrassen(int, int, int, const double*, int,
+                              const double*, int, double*, int, double*);
@@ -0,0 +1,91 @@
+#include "s21_matrix_transpose.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+inline std::size_t Offset(int row, int ld) {
+  return static_cast<std::size_t>(row) * ld;
+}
+
+// Меняет местами x (rows x cols) и транспонированную y (cols x rows):
+// x(i, j) <-> y(j, i). Блоки не пересекаются
+template <typename T>
+void SwapTransposed(int rows, int cols, T* x, T* y, int ld) {
+  if (rows <= kS21TransposeLeaf && cols <= kS21TransposeLeaf) {
+    for (int i = 0; i < rows; ++i) {
+      T* row = x + Offset(i, ld);
+      for (int j = 0; j < cols; ++j) {
+        std::swap(row[j], y[Offset(j, ld) + i]);
+      }
+    }
+  } else if (rows >= cols) {
+    const int half = rows / 2;
+    SwapTransposed(half, cols, x, y, ld);
+    SwapTransposed(rows - half, cols, x + Offset(half, ld), y + half, ld);
+  } else {
+    const int half = cols / 2;
+    SwapTransposed(rows, half, x, y, ld);
+    SwapTransposed(rows, cols - half, x + half, y + Offset(half, ld), ld);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21TransposeCopy(int rows, int cols, const T* src, int lds, T* dst,
+                      int ldd) {
+  if (rows <= kS21TransposeLeaf && cols <= kS21TransposeLeaf) {
+    for (int i = 0; i < rows; ++i) {
+      const T* row = src + Offset(i, lds);
+      for (int j = 0; j < cols; ++j) {
+        dst[Offset(j, ldd) + i] = row[j];
+      }
+    }
+  } else if (rows >= cols) {
+    // Верхняя и нижняя половины источника — левая и правая половины
+    // результата
+    const int half = rows / 2;
+    S21TransposeCopy(half, cols, src, lds, dst, ldd);
+    S21TransposeCopy(rows - half, cols, src + Offset(half, lds), lds,
+                     dst + half, ldd);
+  } else {
+    const int half = cols / 2;
+    S21TransposeCopy(rows, half, src, lds, dst, ldd);
+    S21TransposeCopy(rows, cols - half, src + half, lds,
+                     dst + Offset(half, ldd), ldd);
+  }
+}
+
+template <typename T>
+void S21TransposeInPlace(int n, T* a, int lda) {
+  if (n <= kS21TransposeLeaf) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        std::swap(a[Offset(i, lda) + j], a[Offset(j, lda) + i]);
+      }
+    }
+    return;
+  }
+  // [A11 A12; A21 A22]^T = [A11^T A21^T; A12^T A22^T]
+  const int half = n / 2;
+  S21TransposeInPlace(half, a, lda);
+  S21TransposeInPlace(n - half, a + Offset(half, lda) + half, lda);
+  SwapTransposed(half, n - half, a + half, a + Offset(half, lda), lda);
+}
+
+template void S21TransposeCopy(int, int, const float*, int, float*, int);
+template void S21TransposeCopy(int, int, const double*, int, double*, int);
+template void S21TransposeCopy(int, int, const long double*, int,
+                               long double*, int);
+template void S21TransposeCopy(int, int, const int*, int, int*, int);
+template void S21TransposeCopy(int, int, const std::int64_t*, int,
+                               std::int64_t*, int);
+
+template void S21TransposeInPlace(int, float*, int);
+template void S21TransposeInPlace(int, double*, int);
+template void S21TransposeInPlace(int, long double*, int);
+template void S21TransposeInPlace(int, int*, int);
+template void S21TransposeInPlace(int, std::int64_t*, int);
@@ -0,0 +1,31 @@
+#ifndef S21_MATRIX_TRANSPOSE_H
+#define S21_MATRIX_TRANSPOSE_H
+
+// Транспонирование плотных матриц, заданных указателем на элемент (0, 0)
+// и шагом строки в элементах, как в хранилище S21BasicMatrix.
+//
+// Простой цикл читает источник по строкам, а результат пишет по столбцам:
+// каждая запись попадает в новую кэш-линию и, для больших матриц, в новую
+// страницу. Здесь матрица рекурсивно делится пополам по большему
+// измерению, пока блок не станет не больше kS21TransposeLeaf x
+// kS21TransposeLeaf. Такой блок источника и блок результата помещаются в
+// L1, а на каждом уровне рекурсии блоки помещаются в соответствующий
+// уровень кэша, каким бы ни был его размер (cache-oblivious алгоритм).
+// Собрано для float, double, long double, int и std::int64_t.
+
+// Наибольшая сторона блока, транспонируемого простым циклом
+constexpr int kS21TransposeLeaf = 16;
+
+// Записывает в dst (cols x rows, шаг ldd) транспонированную матрицу src
+// (rows x cols, шаг lds). src и dst не должны пересекаться
+template <typename T>
+void S21TransposeCopy(int rows, int cols, const T* src, int lds, T* dst,
+                      int ldd);
+
+// Транспонирует квадратную матрицу n x n на месте: диагональные блоки
+// транспонируются рекурсивно, внедиагональные меняются местами с
+// одновременным транспонированием
+template <typename T>
+void S21TransposeInPlace(int n, T* a, int lda);
+
+#endif  // S21_MATRIX_TRANSPOSE_H
@@ -0,0 +1,316 @@
+#include "s21_matrix_vector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+template <typename T>
+S21BasicVector<T>::S21BasicVector()
+    : size_(0), data_(nullptr), allocator_(nullptr) {}
+
+template <typename T>
+S21BasicVector<T>::S21BasicVector(int size) : S21BasicVector() {
+  if (size <= 0) {
+    throw std::invalid_argument("Vector size must be greater than zero");
+  }
+  Allocate(size);
+}
+
+template <typename T>
+S21BasicVector<T>::S21BasicVector(const std::vector<T>& values)
+    : S21BasicVector(static_cast<int>(values.size())) {
+  std::copy(values.begin(), values.end(), data_);
+}
+
+template <typename T>
+S21BasicVector<T>::S21BasicVector(const S21BasicVector& other)
+    : S21BasicVector() {
+  if (other.data_ != nullptr) {
+    Allocate(other.size_);
+    std::memcpy(data_, other.data_, sizeof(T) * size_);
+  }
+}
+
+template <typename T>
+S21BasicVector<T>::S21BasicVector(S21BasicVector&& other) noexcept
+    : size_(other.size_), data_(other.data_), allocator_(other.allocator_) {
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+template <typename T>
+S21BasicVector<T>& S21BasicVector<T>::operator=(const S21BasicVector& other) {
+  if (this != &other) {
+    // Буфер того же размера переиспользуется
+    if (size_ != other.size_ || other.data_ == nullptr) {
+      Free();
+      if (other.data_ != nullptr) {
+        Allocate(other.size_);
+      }
+    }
+    if (other.data_ != nullptr) {
+      std::memcpy(data_, other.data_, sizeof(T) * size_);
+    }
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicVector<T>& S21BasicVector<T>::operator=(
+    S21BasicVector&& other) noexcept {
+  if (this != &other) {
+    Free();
+    size_ = other.size_;
+    data_ = other.data_;
+    allocator_ = other.allocator_;
+    other.size_ = 0;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+template <typename T>
+S21BasicVector<T>::~S21BasicVector() { Free(); }
+
+template <typename T>
+void S21BasicVector<T>::Allocate(int size) {
+  allocator_ = S21GetAllocator();
+  data_ = static_cast<T*>(allocator_->Allocate(sizeof(T) * size, kAlignment));
+  std::memset(data_, 0, sizeof(T) * size);
+  size_ = size;
+}
+
+template <typename T>
+void S21BasicVector<T>::Free() {
+  if (data_ != nullptr) {
+    allocator_->Deallocate(data_, sizeof(T) * size_, kAlignment);
+    data_ = nullptr;
+  }
+  size_ = 0;
+}
+
+template <typename T>
+int S21BasicVector<T>::GetSize() const { return size_; }
+
+template <typename T>
+T* S21BasicVector<T>::data() { return data_; }
+template <typename T>
+const T* S21BasicVector<T>::data() const { return data_; }
+template <typename T>
+T* S21BasicVector<T>::begin() { return data_; }
+template <typename T>
+T* S21BasicVector<T>::end() { return data_ + size_; }
+template <typename T>
+const T* S21BasicVector<T>::begin() const { return data_; }
+template <typename T>
+const T* S21BasicVector<T>::end() const { return data_ + size_; }
+
+template <typename T>
+T& S21BasicVector<T>::operator()(int i) {
+  if (i < 0 || i >= size_) {
+    throw std::out_of_range("Vector index is out of range");
+  }
+  return data_[i];
+}
+
+template <typename T>
+const T& S21BasicVector<T>::operator()(int i) const {
+  if (i < 0 || i >= size_) {
+    throw std::out_of_range("Vector index is out of range");
+  }
+  return data_[i];
+}
+
+template <typename T>
+void S21Gemv(S21Transpose trans, int m, int n, T alpha, const T* a, int lda,
+             const T* x, T beta, T* y) {
+  const long long work = static_cast<long long>(m) * n;
+  if (trans == S21Transpose::kNo) {
+    // y_i — скалярное произведение строки i с x; строки независимы
+    S21ParallelFor(m, work, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        const T sum =
+            alpha * S21KernelDot(n, a + static_cast<std::size_t>(i) * lda, x);
+        y[i] = beta == 0 ? sum : sum + beta * y[i];
+      }
+    });
+    return;
+  }
+  // y += alpha * x_i * (строка i): поток получает свой отрезок столбцов y
+  // и проходит по нему все строки A, поэтому y не нужно собирать из
+  // частичных сумм
+  S21ParallelFor(n, work, [&](int begin, int end) {
+    T* y_part = y + begin;
+    const int length = end - begin;
+    if (beta == 0) {
+      std::fill(y_part, y_part + length, T(0));
+    } else if (beta != 1) {
+      S21KernelScale(length, y_part, beta);
+    }
+    for (int i = 0; i < m; ++i) {
+      const T factor = alpha * x[i];
+      if (factor != 0) {
+        S21KernelAxpy(length, factor,
+                      a + static_cast<std::size_t>(i) * lda + begin, y_part);
+      }
+    }
+  });
+}
+
+template <typename T>
+void S21Ger(int m, int n, T alpha, const T* x, const T* y, T* a, int lda) {
+  S21ParallelFor(m, static_cast<long long>(m) * n, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const T factor = alpha * x[i];
+      if (factor != 0) {
+        S21KernelAxpy(n, factor, y, a + static_cast<std::size_t>(i) * lda);
+      }
+    }
+  });
+}
+
+namespace {
+
+void CheckSize(bool matches) {
+  if (!matches) {
+    throw std::invalid_argument(
+        "Vector size must match the dimension of the operation.");
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21Gemv(S21Transpose trans, T alpha, const S21BasicMatrix<T>& a,
+             const S21BasicVector<T>& x, T beta, S21BasicVector<T>* y) {
+  const bool transposed = trans == S21Transpose::kYes;
+  const int rows = transposed ? a.GetCols() : a.GetRows();
+  const int cols = transposed ? a.GetRows() : a.GetCols();
+  CheckSize(x.GetSize() == cols && y->GetSize() == rows);
+  S21Gemv(trans, a.GetRows(), a.GetCols(), alpha, a.data(), a.GetStride(),
+          x.data(), beta, y->data());
+}
+
+template <typename T>
+void S21Ger(T alpha, const S21BasicVector<T>& x, const S21BasicVector<T>& y,
+            S21BasicMatrix<T>* a) {
+  CheckSize(x.GetSize() == a->GetRows() && y.GetSize() == a->GetCols());
+  S21Ger(a->GetRows(), a->GetCols(), alpha, x.data(), y.data(), a->data(),
+         a->GetStride());
+}
+
+template <typename T>
+void S21Axpy(T alpha, const S21BasicVector<T>& x, S21BasicVector<T>* y) {
+  CheckSize(x.GetSize() == y->GetSize());
+  const T* src = x.data();
+  T* dst = y->data();
+  S21ParallelFor(x.GetSize(), x.GetSize(), [&](int begin, int end) {
+    S21KernelAxpy(end - begin, alpha, src + begin, dst + begin);
+  });
+}
+
+template <typename T>
+T S21Dot(const S21BasicVector<T>& x, const S21BasicVector<T>& y) {
+  CheckSize(x.GetSize() == y.GetSize());
+  return S21KernelDot(x.GetSize(), x.data(), y.data());
+}
+
+template <typename T>
+S21BasicVector<T> operator*(const S21BasicMatrix<T>& a,
+                            const S21BasicVector<T>& x) {
+  S21BasicVector<T> y(a.GetRows());
+  S21Gemv(S21Transpose::kNo, T(1), a, x, T(0), &y);
+  return y;
+}
+
+template class S21BasicVector<float>;
+template class S21BasicVector<double>;
+template class S21BasicVector<long double>;
+template class S21BasicVector<int>;
+template class S21BasicVector<std::int64_t>;
+
+template void S21Gemv(S21Transpose, int, int, float, const float*, int,
+                      const float*, float, float*);
+template void S21Gemv(S21Transpose, int, int, double, const double*, int,
+                      const double*, double, double*);
+template void S21Gemv(S21Transpose, int, int, long double, const long double*,
+                      int, const long double*, long double, long double*);
+template void S21Gemv(S21Transpose, int, int, int, const int*, int,
+                      const int*, int, int*);
+template void S21Gemv(S21Transpose, int, int, std::int64_t,
+                      const std::int64_t*, int, const std::int64_t*,
+                      std::int64_t, std::int64_t*);
+
+template void S21Ger(int, int, float, const float*, const float*, float*,
+                     int);
+template void S21Ger(int, int, double, const double*, const double*, double*,
+                     int);
+template void S21Ger(int, int, long double, const long double*,
+                     const long double*, long double*, int);
+template void S21Ger(int, int, int, const int*, const int*, int*, int);
+template void S21Ger(int, int, std::int64_t, const std::int64_t*,
+                     const std::int64_t*, std::int64_t*, int);
+
+template void S21Gemv(S21Transpose, float, const S21BasicMatrix<float>&,
+                      const S21BasicVector<float>&, float,
+                      S21BasicVector<float>*);
+template void S21Gemv(S21Transpose, double, const S21BasicMatrix<double>&,
+                      const S21BasicVector<double>&, double,
+                      S21BasicVector<double>*);
+template void S21Gemv(S21Transpose, long double,
+                      const S21BasicMatrix<long double>&,
+                      const S21BasicVector<long double>&, long double,
+                      S21BasicVector<long double>*);
+template void S21Gemv(S21Transpose, int, const S21BasicMatrix<int>&,
+                      const S21BasicVector<int>&, int, S21BasicVector<int>*);
+template void S21Gemv(S21Transpose, std::int64_t,
+                      const S21BasicMatrix<std::int64_t>&,
+                      const S21BasicVector<std::int64_t>&, std::int64_t,
+                      S21BasicVector<std::int64_t>*);
+
+template void S21Ger(float, const S21BasicVector<float>&,
+                     const S21BasicVector<float>&, S21BasicMatrix<float>*);
+template void S21Ger(double, const S21BasicVector<double>&,
+                     const S21BasicVector<double>&, S21BasicMatrix<double>*);
+template void S21Ger(long double, const S21BasicVector<long double>&,
+                     const S21BasicVector<long double>&,
+                     S21BasicMatrix<long double>*);
+template void S21Ger(int, const S21BasicVector<int>&,
+                     const S21BasicVector<int>&, S21BasicMatrix<int>*);
+template void S21Ger(std::int64_t, const S21BasicVector<std::int64_t>&,
+                     const S21BasicVector<std::int64_t>&,
+                     S21BasicMatrix<std::int64_t>*);
+
+template void S21Axpy(float, const S21BasicVector<float>&,
+                      S21BasicVector<float>*);
+template void S21Axpy(double, const S21BasicVector<double>&,
+                      S21BasicVector<double>*);
+template void S21Axpy(long double, const S21BasicVector<long double>&,
+                      S21BasicVector<long double>*);
+template void S21Axpy(int, const S21BasicVector<int>&, S21BasicVector<int>*);
+template void S21Axpy(std::int64_t, const S21BasicVector<std::int64_t>&,
+                      S21BasicVector<std::int64_t>*);
+
+template float S21Dot(const S21BasicVector<float>&,
+                      const S21BasicVector<float>&);
+template double S21Dot(const S21BasicVector<double>&,
+                       const S21BasicVector<double>&);
+template long double S21Dot(const S21BasicVector<long double>&,
+                            const S21BasicVector<long double>&);
+template int S21Dot(const S21BasicVector<int>&, const S21BasicVector<int>&);
+template std::int64_t S21Dot(const S21BasicVector<std::int64_t>&,
+                             const S21BasicVector<std::int64_t>&);
+
+template S21BasicVector<float> operator*(const S21BasicMatrix<float>&,
+                                         const S21BasicVector<float>&);
+template S21BasicVector<double> operator*(const S21BasicMatrix<double>&,
+                                          const S21BasicVector<double>&);
+template S21BasicVector<long double> operator*(
+    const S21BasicMatrix<long double>&, const S21BasicVector<long double>&);
+template S21BasicVector<int> operator*(const S21BasicMatrix<int>&,
+                                       const S21BasicVector<int>&);
+template S21BasicVector<std::int64_t> operator*(
+    const S21BasicMatrix<std::int64_t>&, const S21BasicVector<std::int64_t>&);
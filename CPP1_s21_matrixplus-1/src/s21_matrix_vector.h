@@ -0,0 +1,124 @@
+#ifndef S21_MATRIX_VECTOR_H
+#define S21_MATRIX_VECTOR_H
+
+// Векторы и операции матрица-вектор второго уровня BLAS:
+//   S21Gemv — y = alpha * op(A) * x + beta * y;
+//   S21Ger  — A += alpha * x * y^T (обновление ранга 1);
+//   S21Axpy — y += alpha * x, S21Dot — скалярное произведение.
+// Результат пишется в объект вызывающего, поэтому итерационные методы
+// (степенной метод, сопряженные градиенты) не выделяют память на каждой
+// итерации. Строки матрицы обрабатываются векторными ядрами
+// (s21_matrix_kernels.h), большие задачи делятся между потоками пула.
+// Собрано для float, double, long double, int и std::int64_t.
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_oop.h"
+
+// Вектор-столбец из size элементов типа T в выровненном буфере
+template <typename T>
+class S21BasicVector {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "Vector elements must be numbers");
+
+ public:
+  using value_type = T;
+
+  // Выравнивание буфера, как у строк S21BasicMatrix
+  static constexpr std::size_t kAlignment = 64;
+
+  // Пустой вектор без буфера
+  S21BasicVector();
+
+  // Вектор из size нулей; бросает std::invalid_argument, если size <= 0
+  explicit S21BasicVector(int size);
+
+  // Копия элементов values
+  explicit S21BasicVector(const std::vector<T>& values);
+
+  S21BasicVector(const S21BasicVector& other);
+  S21BasicVector(S21BasicVector&& other) noexcept;
+  S21BasicVector& operator=(const S21BasicVector& other);
+  S21BasicVector& operator=(S21BasicVector&& other) noexcept;
+  ~S21BasicVector();
+
+  int GetSize() const;
+
+  T* data();
+  const T* data() const;
+  T* begin();
+  T* end();
+  const T* begin() const;
+  const T* end() const;
+
+  // Элемент i; бросает std::out_of_range для индекса вне вектора
+  T& operator()(int i);
+  const T& operator()(int i) const;
+
+  // Элемент i без проверки индекса
+  T& operator[](int i) { return data_[i]; }
+  const T& operator[](int i) const { return data_[i]; }
+
+ private:
+  void Allocate(int size);
+  void Free();
+
+  int size_;
+  T* data_;
+  S21Allocator* allocator_;  // Распределитель, выделивший data_
+};
+
+using S21Vector = S21BasicVector<double>;
+using S21VectorF = S21BasicVector<float>;
+using S21VectorLD = S21BasicVector<long double>;
+using S21VectorI = S21BasicVector<int>;
+using S21VectorI64 = S21BasicVector<std::int64_t>;
+
+// y = alpha * op(A) * x + beta * y для матрицы A m x n с шагом lda;
+// op(A) — A или A^T. x содержит столько элементов, сколько столбцов у
+// op(A), y — сколько строк. При beta == 0 прежнее содержимое y не
+// читается. x и y не должны пересекаться
+template <typename T>
+void S21Gemv(S21Transpose trans, int m, int n, T alpha, const T* a, int lda,
+             const T* x, T beta, T* y);
+
+// A += alpha * x * y^T для матрицы A m x n с шагом lda, x из m и y из n
+// элементов
+template <typename T>
+void S21Ger(int m, int n, T alpha, const T* x, const T* y, T* a, int lda);
+
+// Те же операции над матрицами и векторами. Бросают
+// std::invalid_argument при несовпадении размеров
+
+template <typename T>
+void S21Gemv(S21Transpose trans, T alpha, const S21BasicMatrix<T>& a,
+             const S21BasicVector<T>& x, T beta, S21BasicVector<T>* y);
+
+template <typename T>
+void S21Ger(T alpha, const S21BasicVector<T>& x, const S21BasicVector<T>& y,
+            S21BasicMatrix<T>* a);
+
+// y += alpha * x
+template <typename T>
+void S21Axpy(T alpha, const S21BasicVector<T>& x, S21BasicVector<T>* y);
+
+template <typename T>
+T S21Dot(const S21BasicVector<T>& x, const S21BasicVector<T>& y);
+
+// A * x в новом векторе
+template <typename T>
+S21BasicVector<T> operator*(const S21BasicMatrix<T>& a,
+                            const S21BasicVector<T>& x);
+
+extern template class S21BasicVector<float>;
+extern template class S21BasicVector<double>;
+extern template class S21BasicVector<long double>;
+extern template class S21BasicVector<int>;
+extern template class S21BasicVector<std::int64_t>;
+
+#endif  // S21_MATRIX_VECTOR_H
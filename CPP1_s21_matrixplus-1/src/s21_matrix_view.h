@@ -0,0 +1,359 @@
+#ifndef S21_MATRIX_VIEW_H
+#define S21_MATRIX_VIEW_H
+
+// Невладеющие виды на элементы матрицы. Вид хранит указатель на элемент
+// (0, 0), шаги по строкам и столбцам и, возможно, одну исключенную строку
+// и один исключенный столбец. Так без копирования описываются блок
+// матрицы (Block), минор (Minor) и транспонированная матрица (Transpose).
+//
+// Вид — лист ленивого выражения (см. s21_matrix_expr.h): его можно
+// складывать, вычитать, умножать на число, сравнивать и присваивать в
+// матрицы и другие виды. Вид не продлевает жизнь матрицы и становится
+// недействительным после ее уничтожения или изменения размера.
+//
+// S21MatrixView позволяет менять элементы, S21ConstMatrixView — только
+// читать; изменяемый вид неявно приводится к константному.
+
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_oop.h"
+
+// T — тип элемента, для константного вида — const-тип
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ public:
+  using value_type = std::remove_const_t<T>;
+  using Matrix = S21BasicMatrix<value_type>;
+  using MatrixRef =
+      std::conditional_t<std::is_const_v<T>, const Matrix&, Matrix&>;
+
+  // Курсор строки для вычисления выражений
+  struct RowCursor {
+    T* base;
+    std::ptrdiff_t stride;
+    int skip;
+    T& operator[](int j) const { return base[(j + (j >= skip)) * stride]; }
+  };
+
+  // Вид на всю матрицу
+  S21BasicMatrixView(MatrixRef matrix)
+      : S21BasicMatrixView(matrix.data(), matrix.GetRows(), matrix.GetCols(),
+                           matrix.GetStride()) {}
+
+  // Вид на произвольный участок памяти: элемент (i, j) лежит по адресу
+  // data + i * row_stride + j * col_stride
+  S21BasicMatrixView(T* data, int rows, int cols, std::ptrdiff_t row_stride,
+                     std::ptrdiff_t col_stride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride),
+        skip_row_(kNone),
+        skip_col_(kNone) {
+    if (rows < 0 || cols < 0) {
+      throw std::invalid_argument(
+          "Number of rows and columns must not be negative");
+    }
+  }
+
+  // Изменяемый вид приводится к константному
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other)
+      : data_(other.data_),
+        rows_(other.rows_),
+        cols_(other.cols_),
+        row_stride_(other.row_stride_),
+        col_stride_(other.col_stride_),
+        skip_row_(other.skip_row_),
+        skip_col_(other.skip_col_) {}
+
+  S21BasicMatrixView(const S21BasicMatrixView& other) = default;
+
+  // Изменяемый вид копирует элементы other (размеры должны совпадать),
+  // константный — начинает смотреть туда же, куда other
+  S21BasicMatrixView& operator=(const S21BasicMatrixView& other) {
+    if constexpr (std::is_const_v<T>) {
+      data_ = other.data_;
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      row_stride_ = other.row_stride_;
+      col_stride_ = other.col_stride_;
+      skip_row_ = other.skip_row_;
+      skip_col_ = other.skip_col_;
+    } else {
+      Assign(other);
+    }
+    return *this;
+  }
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  std::ptrdiff_t GetRowStride() const { return row_stride_; }
+  std::ptrdiff_t GetColStride() const { return col_stride_; }
+
+  // Элементы строки идут подряд и ничего не исключено: такой вид можно
+  // передавать в функции, принимающие указатель и шаг строки
+  bool IsDense() const {
+    return col_stride_ == 1 && skip_row_ == kNone && skip_col_ == kNone;
+  }
+
+  // Транспонированный плотный вид: элементы столбца идут подряд. Такой
+  // вид передается в S21Gemm как транспонированный операнд с шагом
+  // GetColStride()
+  bool IsDenseTransposed() const {
+    return row_stride_ == 1 && skip_row_ == kNone && skip_col_ == kNone;
+  }
+
+  // Указатель на элемент (0, 0) для плотного вида
+  T* data() const { return data_; }
+
+  T& operator()(int i, int j) const {
+    if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+      throw std::out_of_range("Matrix view indices are out of range");
+    }
+    return *At(i, j);
+  }
+
+  // Блок rows x cols, начинающийся с элемента (row, col)
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::out_of_range("Matrix view block is out of range");
+    }
+    const int first_row = row + (row >= skip_row_);
+    const int first_col = col + (col >= skip_col_);
+    S21BasicMatrixView result(*this);
+    result.data_ = data_ + first_row * row_stride_ + first_col * col_stride_;
+    result.rows_ = rows;
+    result.cols_ = cols;
+    result.skip_row_ = Shift(skip_row_, first_row);
+    result.skip_col_ = Shift(skip_col_, first_col);
+    return result;
+  }
+
+  // Вид без строки row и столбца col. Исключить можно только одну строку
+  // и один столбец, поэтому минор минора не поддерживается
+  S21BasicMatrixView Minor(int row, int col) const {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+      throw std::out_of_range("Matrix view indices are out of range");
+    }
+    if (skip_row_ != kNone || skip_col_ != kNone) {
+      throw std::invalid_argument("Minor of a minor view is not supported");
+    }
+    S21BasicMatrixView result(*this);
+    result.rows_ = rows_ - 1;
+    result.cols_ = cols_ - 1;
+    result.skip_row_ = row;
+    result.skip_col_ = col;
+    return result;
+  }
+
+  // Транспонированный вид: строки и столбцы меняются местами
+  S21BasicMatrixView Transpose() const {
+    S21BasicMatrixView result(*this);
+    std::swap(result.rows_, result.cols_);
+    std::swap(result.row_stride_, result.col_stride_);
+    std::swap(result.skip_row_, result.skip_col_);
+    return result;
+  }
+
+  RowCursor Row(int i) const {
+    return RowCursor{data_ + (i + (i >= skip_row_)) * row_stride_,
+                     col_stride_, skip_col_};
+  }
+
+  // Определитель: до порядка 3 по явным формулам прямо по виду, для
+  // больших — через копию, которую все равно требует LU-разложение
+  value_type Determinant() const;
+
+  // Присваивание и составное присваивание выражения. Операнды могут
+  // совпадать с видом только поэлементно (a = a + b), но не со сдвигом
+  template <typename E>
+  S21BasicMatrixView& operator=(const S21MatrixExpr<E>& expr) {
+    Assign(expr.Self());
+    return *this;
+  }
+
+  template <typename E>
+  S21BasicMatrixView& operator+=(const S21MatrixExpr<E>& expr) {
+    Assign(*this + expr);
+    return *this;
+  }
+
+  template <typename E>
+  S21BasicMatrixView& operator-=(const S21MatrixExpr<E>& expr) {
+    Assign(*this - expr);
+    return *this;
+  }
+
+  S21BasicMatrixView& operator*=(const value_type num) {
+    Assign(*this * num);
+    return *this;
+  }
+
+ private:
+  template <typename U>
+  friend class S21BasicMatrixView;
+
+  // Нет исключенной строки или столбца: индекс никогда не достигается
+  static constexpr int kNone = INT_MAX;
+
+  // Номер исключенной строки относительно блока, начинающегося с first
+  static int Shift(int skip, int first) {
+    return skip == kNone || skip < first ? kNone : skip - first;
+  }
+
+  T* At(int i, int j) const {
+    return data_ + (i + (i >= skip_row_)) * row_stride_ +
+           (j + (j >= skip_col_)) * col_stride_;
+  }
+
+  template <typename E>
+  void Assign(const E& source) {
+    static_assert(!std::is_const_v<T>, "Cannot assign to a const view");
+    static_assert(std::is_same_v<typename E::value_type, value_type>,
+                  "Expression and view element types must match");
+    // Матрица читается через лист выражения, узлы — напрямую
+    const typename S21ExprOperand<E>::Type expr(source);
+    if (expr.GetRows() != rows_ || expr.GetCols() != cols_) {
+      throw std::invalid_argument(
+          "Matrices must have the same dimensions for assignment.");
+    }
+    for (int i = 0; i < rows_; ++i) {
+      const auto src = expr.Row(i);
+      const RowCursor dst = Row(i);
+      for (int j = 0; j < cols_; ++j) {
+        dst[j] = src[j];
+      }
+    }
+  }
+
+  T* data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+  int skip_row_, skip_col_;
+};
+
+template <typename T>
+using S21BasicConstMatrixView = S21BasicMatrixView<const T>;
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+
+template <typename T>
+typename S21BasicMatrixView<T>::value_type
+S21BasicMatrixView<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Determinant can only be calculated for square matrices.");
+  }
+  switch (rows_) {
+    case 0:
+      // Пустое произведение: минор матрицы 1x1
+      return 1;
+    case 1:
+      return *At(0, 0);
+    case 2:
+      return *At(0, 0) * *At(1, 1) - *At(0, 1) * *At(1, 0);
+    case 3:
+      return *At(0, 0) * (*At(1, 1) * *At(2, 2) - *At(1, 2) * *At(2, 1)) -
+             *At(0, 1) * (*At(1, 0) * *At(2, 2) - *At(1, 2) * *At(2, 0)) +
+             *At(0, 2) * (*At(1, 0) * *At(2, 1) - *At(1, 1) * *At(2, 0));
+    default:
+      return Matrix(*this).Determinant();
+  }
+}
+
+// C = A * B (или C += A * B при accumulate). Плотные и транспонированные
+// плотные виды умножаются прямо на месте через S21Gemm: транспонирование
+// операнда передается флагом, а в транспонированный результат пишется
+// C^T = B^T * A^T. Миноры и виды с произвольными шагами сначала
+// копируются в матрицы
+template <typename A, typename B, typename T>
+void S21MulViews(const S21BasicMatrixView<A>& a,
+                 const S21BasicMatrixView<B>& b,
+                 const S21BasicMatrixView<T>& c, bool accumulate = false) {
+  using Value = typename S21BasicMatrixView<T>::value_type;
+  static_assert(!std::is_const_v<T>, "Cannot write to a const view");
+  static_assert(std::is_same_v<std::remove_const_t<A>, Value> &&
+                    std::is_same_v<std::remove_const_t<B>, Value>,
+                "Views must have the same element type");
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "The number of columns of the first matrix must be equal to the number "
+        "of rows of the second matrix.");
+  }
+  if (c.GetRows() != a.GetRows() || c.GetCols() != b.GetCols()) {
+    throw std::invalid_argument(
+        "The result must have as many rows as the first matrix and as many "
+        "columns as the second.");
+  }
+  if (!a.IsDense() && !a.IsDenseTransposed()) {
+    const S21BasicMatrix<Value> copy(a);
+    S21MulViews(S21BasicConstMatrixView<Value>(copy), b, c, accumulate);
+  } else if (!b.IsDense() && !b.IsDenseTransposed()) {
+    const S21BasicMatrix<Value> copy(b);
+    S21MulViews(a, S21BasicConstMatrixView<Value>(copy), c, accumulate);
+  } else if (!c.IsDense() && !c.IsDenseTransposed()) {
+    S21BasicMatrix<Value> product(c.GetRows(), c.GetCols());
+    S21MulViews(a, b, S21BasicMatrixView<Value>(product));
+    S21BasicMatrixView<T> target(c);
+    if (accumulate) {
+      target += product;
+    } else {
+      target = product;
+    }
+  } else if (c.GetRows() > 0 && c.GetCols() > 0) {
+    // Вектор-строка или вектор-столбец плотен в обоих смыслах; тогда
+    // используется обычная раскладка
+    const bool ta = !a.IsDense();
+    const bool tb = !b.IsDense();
+    const int lda = static_cast<int>(ta ? a.GetColStride() : a.GetRowStride());
+    const int ldb = static_cast<int>(tb ? b.GetColStride() : b.GetRowStride());
+    const auto flag = [](bool trans) {
+      return trans ? S21Transpose::kYes : S21Transpose::kNo;
+    };
+    if (c.IsDense()) {
+      S21Gemm(flag(ta), flag(tb), a.GetRows(), b.GetCols(), a.GetCols(),
+              a.data(), lda, b.data(), ldb, c.data(),
+              static_cast<int>(c.GetRowStride()), accumulate);
+    } else {
+      S21Gemm(flag(!tb), flag(!ta), b.GetCols(), a.GetRows(), a.GetCols(),
+              b.data(), ldb, a.data(), lda, c.data(),
+              static_cast<int>(c.GetColStride()), accumulate);
+    }
+  }
+}
+
+// Произведения видов и матриц в новую матрицу через S21MulViews. Эти
+// перегрузки точнее общего произведения выражений, которое сначала
+// копирует операнды
+template <typename A, typename B>
+S21BasicMatrix<std::remove_const_t<A>> operator*(
+    const S21BasicMatrixView<A>& a, const S21BasicMatrixView<B>& b) {
+  S21BasicMatrix<std::remove_const_t<A>> result(a.GetRows(), b.GetCols());
+  S21MulViews(a, b, S21BasicMatrixView<std::remove_const_t<A>>(result));
+  return result;
+}
+
+template <typename T, typename B>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& a,
+                            const S21BasicMatrixView<B>& b) {
+  return S21BasicConstMatrixView<T>(a) * b;
+}
+
+template <typename A, typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<A>& a,
+                            const S21BasicMatrix<T>& b) {
+  return a * S21BasicConstMatrixView<T>(b);
+}
+
+#endif  // S21_MATRIX_VIEW_H
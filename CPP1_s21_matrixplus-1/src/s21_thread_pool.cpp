@@ -0,0 +1,174 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Число частей на поток: небольшой запас сглаживает неравномерную нагрузку
+constexpr int kTasksPerThread = 4;
+
+// Порог по умолчанию: около 10^5 операций, меньшие задачи не окупают
+// пробуждение рабочих потоков
+std::atomic<long long> g_parallel_cutoff{1LL << 17};
+
+// Выполняет ли текущий поток часть параллельной задачи
+thread_local bool t_inside_task = false;
+
+int ResolveThreadCount(int threads) {
+  if (threads < 0) {
+    throw std::invalid_argument("Number of threads must not be negative");
+  }
+  if (threads == 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  return std::max(threads, 1);
+}
+
+}  // namespace
+
+S21ThreadPool::S21ThreadPool(int threads) {
+  Start(ResolveThreadCount(threads));
+}
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+S21ThreadPool& S21ThreadPool::Shared() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+int S21ThreadPool::GetThreadCount() const { return thread_count_.load(); }
+
+void S21ThreadPool::SetThreadCount(int threads) {
+  const int resolved = ResolveThreadCount(threads);
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  if (resolved != thread_count_.load()) {
+    Stop();
+    Start(resolved);
+  }
+}
+
+void S21ThreadPool::Start(int threads) {
+  stop_ = false;
+  thread_count_ = threads;
+  // Поколение передается явно: поток может запуститься уже после того,
+  // как вызывающий поток опубликовал первую задачу
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, generation_);
+  }
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void S21ThreadPool::WorkerLoop(unsigned long seen) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) {
+      return;
+    }
+    seen = generation_;
+    lock.unlock();
+    RunTasks();
+    lock.lock();
+    if (--pending_workers_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+void S21ThreadPool::RunTasks() {
+  const bool was_inside = t_inside_task;
+  t_inside_task = true;
+  for (int task = next_task_.fetch_add(1); task < tasks_;
+       task = next_task_.fetch_add(1)) {
+    // Части делятся поровну с точностью до одного элемента
+    const long long count = count_;
+    const int begin = static_cast<int>(count * task / tasks_);
+    const int end = static_cast<int>(count * (task + 1) / tasks_);
+    try {
+      (*body_)(begin, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+  t_inside_task = was_inside;
+}
+
+void S21ThreadPool::ParallelFor(int count,
+                                const std::function<void(int, int)>& body) {
+  if (count <= 0) {
+    return;
+  }
+  // Без рабочих потоков, внутри другой задачи или пока пул занят другим
+  // вызывающим потоком выполняем все последовательно
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::defer_lock);
+  if (count == 1 || t_inside_task || !run_lock.try_lock() ||
+      workers_.empty()) {
+    body(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    tasks_ = std::min(count, thread_count_.load() * kTasksPerThread);
+    next_task_ = 0;
+    pending_workers_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    ++generation_;
+  }
+  wake_.notify_all();
+  RunTasks();
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_workers_ == 0; });
+    body_ = nullptr;
+    error = error_;
+    error_ = nullptr;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void S21SetThreadCount(int threads) {
+  S21ThreadPool::Shared().SetThreadCount(threads);
+}
+
+int S21GetThreadCount() { return S21ThreadPool::Shared().GetThreadCount(); }
+
+void S21SetParallelCutoff(long long work) {
+  if (work < 0) {
+    throw std::invalid_argument("Parallel cutoff must not be negative");
+  }
+  g_parallel_cutoff = work;
+}
+
+long long S21GetParallelCutoff() { return g_parallel_cutoff.load(); }
+
+void S21ParallelFor(int count, long long work,
+                    const std::function<void(int, int)>& body) {
+  if (work < g_parallel_cutoff.load()) {
+    body(0, count);
+  } else {
+    S21ThreadPool::Shared().ParallelFor(count, body);
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков для параллельных операций над матрицами. Вызывающий поток
+// тоже выполняет часть работы, поэтому пул из N потоков держит N - 1
+// рабочих. Вложенный вызов ParallelFor из задачи выполняется
+// последовательно в текущем потоке.
+class S21ThreadPool {
+ public:
+  // threads — общее число потоков; 0 означает число аппаратных потоков
+  explicit S21ThreadPool(int threads = 0);
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  // Общий пул, которым пользуются операции S21Matrix
+  static S21ThreadPool& Shared();
+
+  int GetThreadCount() const;
+  // Пересоздает рабочие потоки; дожидается окончания текущей задачи
+  void SetThreadCount(int threads);
+
+  // Разбивает [0, count) на непрерывные части и вызывает body(begin, end)
+  // для каждой части в потоках пула. Возвращает управление, когда все
+  // части выполнены; первое исключение из body пробрасывается дальше
+  void ParallelFor(int count, const std::function<void(int, int)>& body);
+
+ private:
+  void Start(int threads);
+  void Stop();
+  void WorkerLoop(unsigned long seen);
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+  std::atomic<int> thread_count_{1};
+
+  std::mutex run_mutex_;  // Одна параллельная задача за раз
+  std::mutex mutex_;      // Защищает поля текущей задачи
+  std::condition_variable wake_;
+  std::condition_variable done_;
+
+  const std::function<void(int, int)>* body_ = nullptr;
+  int count_ = 0;
+  int tasks_ = 0;
+  std::atomic<int> next_task_{0};
+  int pending_workers_ = 0;
+  unsigned long generation_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+// Настройки параллельного выполнения операций S21Matrix
+
+// Число потоков общего пула; 0 означает число аппаратных потоков
+void S21SetThreadCount(int threads);
+int S21GetThreadCount();
+
+// Минимальный объем работы (число элементов для поэлементных операций,
+// число умножений для произведения), начиная с которого операция
+// распараллеливается. Меньшие задачи выполняются в вызывающем потоке
+void S21SetParallelCutoff(long long work);
+long long S21GetParallelCutoff();
+
+// Выполняет body над [0, count) в общем пуле, если work не меньше порога,
+// иначе одним вызовом body(0, count)
+void S21ParallelFor(int count, long long work,
+                    const std::function<void(int, int)>& body);
+
+#endif  // S21_THREAD_POOL_H
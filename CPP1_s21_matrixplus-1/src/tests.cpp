@@ -12,8 +12,41 @@ EXPECT_EQ(val1, val2) — аналогично ASSERT_EQ, но тест прод
 */
 
 #include <gtest/gtest.h>
-
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_file.h"
+#include "s21_matrix_fixed.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_out_of_core.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_solve.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_transpose.h"
+#include "s21_matrix_vector.h"
+#include "s21_matrix_view.h"
+#include "s21_thread_pool.h"
 
 // Тесты на конструкторы
 TEST(S21MatrixTest, DefaultConstructor) {
@@ -622,6 +655,2537 @@ TEST(Test_SetCols, test_1) {
   ASSERT_ANY_THROW(M.SetCols(0));
 }
 
+TEST(Test_Storage, contiguous_aligned) {
+  S21Matrix M(5, 3);
+  ASSERT_GE(M.GetStride(), M.GetCols());
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(M.data()) % S21Matrix::kAlignment,
+            0u);
+  for (int i = 0; i < M.GetRows(); i++) {
+    for (int j = 0; j < M.GetCols(); j++) {
+      M(i, j) = i * 10 + j;
+    }
+  }
+  for (int i = 0; i < M.GetRows(); i++) {
+    ASSERT_EQ(&M(i, 0), M.data() + i * M.GetStride());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(M.row(i).data()) %
+                  S21Matrix::kAlignment,
+              0u);
+  }
+}
+
+TEST(Test_Storage, row_span) {
+  S21Matrix M(2, 4);
+  int value = 0;
+  for (double& x : M.row(1)) {
+    x = ++value;
+  }
+  const S21Matrix& C = M;
+  ASSERT_EQ(C.row(1).size(), 4);
+  ASSERT_DOUBLE_EQ(C.row(1)[3], 4);
+  ASSERT_DOUBLE_EQ(C(1, 0), 1);
+  ASSERT_DOUBLE_EQ(C(0, 0), 0);
+  ASSERT_THROW(M.row(2), std::out_of_range);
+  ASSERT_THROW(C(-1, 0), std::out_of_range);
+}
+
+TEST(Test_Storage, resize_keeps_values) {
+  S21Matrix M(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      M(i, j) = i * 3 + j;
+    }
+  }
+  M.SetCols(12);
+  M.SetRows(2);
+  ASSERT_EQ(M.GetStride() % 8, 0);
+  ASSERT_DOUBLE_EQ(M(1, 2), 5);
+  ASSERT_DOUBLE_EQ(M(1, 11), 0);
+  S21Matrix copy;
+  copy = M;
+  ASSERT_TRUE(copy == M);
+}
+
+// Заполняет матрицу воспроизводимыми псевдослучайными значениями
+template <typename T>
+void FillMatrix(S21BasicMatrix<T> &M, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (int i = 0; i < M.GetRows(); i++) {
+    for (T &x : M.row(i)) {
+      x = static_cast<T>(dist(gen));
+    }
+  }
+}
+
+TEST(Test_Gemm, blocked_matches_naive) {
+  const S21GemmBlocking saved = S21GetGemmBlocking();
+  // Маленькие блоки, чтобы проверить все хвосты по m, n и k
+  S21SetGemmBlocking({12, 7, 20});
+  const int sizes[][3] = {{1, 1, 1}, {5, 3, 9}, {17, 23, 31}, {40, 9, 33}};
+  for (const auto &size : sizes) {
+    S21Matrix A(size[0], size[2]);
+    S21Matrix B(size[2], size[1]);
+    FillMatrix(A, 1);
+    FillMatrix(B, 2);
+    S21Matrix C1(size[0], size[1]);
+    S21Matrix C2(size[0], size[1]);
+    S21GemmNaive(size[0], size[1], size[2], A.data(), A.GetStride(),
+                 B.data(), B.GetStride(), C1.data(), C1.GetStride());
+    S21GemmBlocked(size[0], size[1], size[2], A.data(), A.GetStride(),
+                   B.data(), B.GetStride(), C2.data(), C2.GetStride());
+    ASSERT_TRUE(C1 == C2);
+  }
+  S21SetGemmBlocking(saved);
+  ASSERT_ANY_THROW(S21SetGemmBlocking({0, 1, 1}));
+}
+
+TEST(Test_Gemm, settings_change_during_multiplication) {
+  const S21GemmBlocking saved = S21GetGemmBlocking();
+  const long long saved_threshold = S21GetGemmThreshold();
+  S21Matrix A(70, 50);
+  S21Matrix B(50, 60);
+  FillMatrix(A, 3);
+  FillMatrix(B, 4);
+  const S21Matrix expected = A * B;
+
+  // Настройки меняются, пока другой поток умножает: любой набор размеров
+  // дает тот же результат
+  std::atomic<bool> done{false};
+  std::thread tuner([&done] {
+    for (int step = 0; !done; step++) {
+      S21SetGemmBlocking({8 + step % 5 * 8, 16 + step % 3 * 8, 32});
+      S21SetGemmThreshold(step % 2 == 0 ? 1 : 1LL << 40);
+    }
+  });
+  bool all_equal = true;
+  for (int i = 0; i < 50; i++) {
+    all_equal = all_equal && A * B == expected;
+  }
+  done = true;
+  tuner.join();
+  S21SetGemmBlocking(saved);
+  S21SetGemmThreshold(saved_threshold);
+  ASSERT_TRUE(all_equal);
+}
+
+TEST(Test_Gemm, operators_dispatch_to_blocked) {
+  const long long saved = S21GetGemmThreshold();
+  S21Matrix A(37, 45);
+  S21Matrix B(45, 29);
+  FillMatrix(A, 3);
+  FillMatrix(B, 4);
+  S21SetGemmThreshold(1LL << 62);
+  S21Matrix expected = A * B;
+  S21SetGemmThreshold(0);
+  S21Matrix product = A * B;
+  S21Matrix in_place(A);
+  in_place *= B;
+  S21Matrix method(A);
+  method.MulMatrix(B);
+  S21SetGemmThreshold(saved);
+  ASSERT_EQ(product.GetRows(), 37);
+  ASSERT_EQ(product.GetCols(), 29);
+  ASSERT_TRUE(product == expected);
+  ASSERT_TRUE(in_place == expected);
+  ASSERT_TRUE(method == expected);
+}
+
+// Все наборы инструкций, доступные в этой сборке на этом процессоре
+std::vector<S21Isa> SupportedIsas() {
+  std::vector<S21Isa> result;
+  for (S21Isa isa : {S21Isa::kScalar, S21Isa::kSse2, S21Isa::kAvx2,
+                     S21Isa::kAvx512}) {
+    if (S21IsaSupported(isa)) {
+      result.push_back(isa);
+    }
+  }
+  return result;
+}
+
+TEST(Test_Kernels, detection) {
+  ASSERT_TRUE(S21IsaSupported(S21Isa::kScalar));
+  ASSERT_TRUE(S21IsaSupported(S21DetectIsa()));
+  ASSERT_EQ(S21GetKernels(S21DetectIsa())->isa, S21DetectIsa());
+}
+
+TEST(Test_Kernels, elementwise_same_on_every_isa) {
+  const S21Isa saved = S21GetActiveIsa();
+  // Нечетное число столбцов задействует и векторную часть, и хвост
+  S21Matrix A(7, 19);
+  S21Matrix B(7, 19);
+  FillMatrix(A, 5);
+  FillMatrix(B, 6);
+  S21SetActiveIsa(S21Isa::kScalar);
+  S21Matrix sum = A + B;
+  S21Matrix diff = A - B;
+  S21Matrix scaled = A * 3.5;
+  for (S21Isa isa : SupportedIsas()) {
+    S21SetActiveIsa(isa);
+    ASSERT_EQ(S21GetActiveIsa(), isa);
+    S21Matrix s = A + B;
+    S21Matrix d = A - B;
+    S21Matrix m = A * 3.5;
+    for (int i = 0; i < A.GetRows(); i++) {
+      for (int j = 0; j < A.GetCols(); j++) {
+        ASSERT_EQ(s(i, j), sum(i, j)) << S21GetKernels().name;
+        ASSERT_EQ(d(i, j), diff(i, j)) << S21GetKernels().name;
+        ASSERT_EQ(m(i, j), scaled(i, j)) << S21GetKernels().name;
+      }
+    }
+    S21Matrix y(B);
+    S21GetKernels().axpy(19, -1.5, A.row(3).data(), y.row(3).data());
+    for (int j = 0; j < A.GetCols(); j++) {
+      ASSERT_NEAR(y(3, j), B(3, j) - 1.5 * A(3, j), 1e-15);
+    }
+    S21Matrix C(A);
+    ASSERT_TRUE(C == A);
+    C(6, 18) += 1e-3;
+    ASSERT_FALSE(C == A) << S21GetKernels().name;
+    C(6, 18) = A(6, 18) + 1e-7;
+    C(0, 1) -= 1e-3;
+    ASSERT_FALSE(C == A) << S21GetKernels().name;
+  }
+  S21SetActiveIsa(saved);
+}
+
+TEST(Test_Kernels, gemm_same_on_every_isa) {
+  const S21Isa saved = S21GetActiveIsa();
+  S21Matrix A(53, 71);
+  S21Matrix B(71, 45);
+  FillMatrix(A, 7);
+  FillMatrix(B, 8);
+  S21Matrix expected(53, 45);
+  S21GemmNaive(53, 45, 71, A.data(), A.GetStride(), B.data(), B.GetStride(),
+               expected.data(), expected.GetStride());
+  for (S21Isa isa : SupportedIsas()) {
+    S21SetActiveIsa(isa);
+    S21Matrix C(53, 45);
+    S21GemmBlocked(53, 45, 71, A.data(), A.GetStride(), B.data(),
+                   B.GetStride(), C.data(), C.GetStride());
+    // FMA меняет округление, поэтому сравниваем с допуском EqMatrix
+    ASSERT_TRUE(C == expected) << S21GetKernels().name;
+  }
+  S21SetActiveIsa(saved);
+}
+
+TEST(Test_Parallel, pool_covers_range_once) {
+  S21ThreadPool pool(4);
+  ASSERT_EQ(pool.GetThreadCount(), 4);
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(1000, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      hits[i]++;
+      // Вложенный вызов выполняется в текущем потоке
+      pool.ParallelFor(3, [](int, int) {});
+    }
+  });
+  for (int h : hits) {
+    ASSERT_EQ(h, 1);
+  }
+  ASSERT_THROW(pool.ParallelFor(10,
+                                [](int begin, int) {
+                                  if (begin > 0) throw std::runtime_error("x");
+                                }),
+               std::runtime_error);
+  pool.SetThreadCount(1);
+  ASSERT_EQ(pool.GetThreadCount(), 1);
+  ASSERT_ANY_THROW(pool.SetThreadCount(-1));
+}
+
+TEST(Test_Parallel, matches_serial) {
+  const int saved_threads = S21GetThreadCount();
+  const long long saved_cutoff = S21GetParallelCutoff();
+  S21Matrix A(67, 93);
+  S21Matrix B(67, 93);
+  S21Matrix C(93, 41);
+  FillMatrix(A, 9);
+  FillMatrix(B, 10);
+  FillMatrix(C, 11);
+
+  S21SetThreadCount(1);
+  S21Matrix sum = A + B;
+  S21Matrix diff = A - B;
+  S21Matrix scaled = A * -2.0;
+  S21Matrix transposed = A.Transpose();
+  S21Matrix product(67, 41);
+  S21GemmBlocked(67, 41, 93, A.data(), A.GetStride(), C.data(), C.GetStride(),
+                 product.data(), product.GetStride());
+
+  S21SetThreadCount(4);
+  S21SetParallelCutoff(0);
+  S21Matrix par_product(67, 41);
+  S21GemmBlocked(67, 41, 93, A.data(), A.GetStride(), C.data(), C.GetStride(),
+                 par_product.data(), par_product.GetStride());
+  S21Matrix par_transposed = A.Transpose();
+  S21Matrix par_sum = A + B;
+  S21Matrix par_diff = A - B;
+  S21Matrix par_scaled = A * -2.0;
+  S21SetThreadCount(saved_threads);
+  S21SetParallelCutoff(saved_cutoff);
+
+  for (int i = 0; i < A.GetRows(); i++) {
+    for (int j = 0; j < A.GetCols(); j++) {
+      ASSERT_EQ(par_sum(i, j), sum(i, j));
+      ASSERT_EQ(par_diff(i, j), diff(i, j));
+      ASSERT_EQ(par_scaled(i, j), scaled(i, j));
+      ASSERT_EQ(par_transposed(j, i), transposed(j, i));
+    }
+  }
+  // Каждая плитка считается тем же последовательным кодом
+  for (int i = 0; i < product.GetRows(); i++) {
+    for (int j = 0; j < product.GetCols(); j++) {
+      ASSERT_EQ(par_product(i, j), product(i, j));
+    }
+  }
+}
+
+TEST(Test_LU, reconstructs_permuted_matrix) {
+  S21Matrix A(9, 9);
+  FillMatrix(A, 12);
+  S21LU lu(A);
+  ASSERT_EQ(lu.GetSize(), 9);
+  ASSERT_FALSE(lu.IsSingular());
+  S21Matrix L(9, 9);
+  S21Matrix U(9, 9);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) {
+      if (j < i) {
+        L(i, j) = lu.GetLU()(i, j);
+      } else {
+        U(i, j) = lu.GetLU()(i, j);
+      }
+    }
+    L(i, i) = 1;
+  }
+  S21Matrix PA(A);
+  for (int k = 0; k < 9; k++) {
+    for (int j = 0; j < 9; j++) {
+      std::swap(PA(k, j), PA(lu.GetPivots()[k], j));
+    }
+  }
+  ASSERT_TRUE(L * U == PA);
+}
+
+TEST(Test_LU, determinant_of_large_matrix) {
+  // A = P * L * U с известной диагональю U: det = -prod(diag)
+  const int n = 12;
+  S21Matrix L(n, n);
+  S21Matrix U(n, n);
+  FillMatrix(L, 13);
+  FillMatrix(U, 14);
+  double expected = -1;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (j > i) L(i, j) = 0;
+      if (j < i) U(i, j) = 0;
+    }
+    L(i, i) = 1;
+    U(i, i) = 1.0 + 0.1 * i;
+    expected *= U(i, i);
+  }
+  S21Matrix A = L * U;
+  A.SetRows(n + 1);
+  for (int j = 0; j < n; j++) {
+    A(n, j) = A(0, j);
+    A(0, j) = A(1, j);
+    A(1, j) = A(n, j);
+  }
+  A.SetRows(n);
+  ASSERT_NEAR(A.Determinant(), expected, 1e-9 * std::fabs(expected));
+}
+
+TEST(Test_LU, solve_and_singular) {
+  S21Matrix A(6, 6);
+  S21Matrix B(6, 3);
+  FillMatrix(A, 15);
+  FillMatrix(B, 16);
+  S21LU lu(A);
+  S21Matrix X = lu.Solve(B);
+  ASSERT_TRUE(A * X == B);
+  ASSERT_ANY_THROW(lu.Solve(S21Matrix(5, 1)));
+
+  // Третья строка — сумма первых двух
+  for (int j = 0; j < 6; j++) {
+    A(2, j) = A(0, j) + A(1, j);
+  }
+  S21LU singular(A);
+  ASSERT_NEAR(singular.Determinant(), 0, 1e-12);
+  ASSERT_NEAR(A.Determinant(), 0, 1e-12);
+  ASSERT_ANY_THROW(S21LU(S21Matrix(2, 3)));
+  S21Matrix Z(4, 4);
+  ASSERT_TRUE(S21LU(Z).IsSingular());
+  ASSERT_ANY_THROW(S21LU(Z).Solve(S21Matrix(4, 1)));
+}
+
+// Алгебраические дополнения по определению: знак * определитель минора
+S21Matrix CofactorsByMinors(const S21Matrix &A) {
+  const int n = A.GetRows();
+  S21Matrix C(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int r = 0, mr = 0; r < n; r++) {
+        if (r == i) continue;
+        for (int c = 0, mc = 0; c < n; c++) {
+          if (c == j) continue;
+          minor(mr, mc++) = A(r, c);
+        }
+        mr++;
+      }
+      C(i, j) = ((i + j) % 2 == 0 ? 1.0 : -1.0) * minor.Determinant();
+    }
+  }
+  return C;
+}
+
+TEST(Test_Inverse, large_matrix_via_lu) {
+  const int n = 100;
+  S21Matrix A(n, n);
+  FillMatrix(A, 17);
+  for (int i = 0; i < n; i++) {
+    A(i, i) += n;
+  }
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) {
+    identity(i, i) = 1;
+  }
+  S21Matrix inverse = A.InverseMatrix();
+  ASSERT_TRUE(A * inverse == identity);
+  ASSERT_TRUE(inverse * A == identity);
+
+  // Вторая строка равна первой
+  for (int j = 0; j < n; j++) {
+    A(1, j) = A(0, j);
+  }
+  ASSERT_ANY_THROW(A.InverseMatrix());
+}
+
+TEST(Test_Inverse, complements_of_regular_matrix) {
+  S21Matrix A(5, 5);
+  FillMatrix(A, 18);
+  S21Matrix expected = CofactorsByMinors(A);
+  ASSERT_TRUE(A.CalcComplements() == expected);
+}
+
+TEST(Test_Inverse, complements_of_singular_matrix) {
+  // Ранг n - 1: последняя строка — комбинация первых двух
+  S21Matrix A(5, 5);
+  FillMatrix(A, 19);
+  for (int j = 0; j < 5; j++) {
+    A(4, j) = 2 * A(0, j) - A(1, j);
+  }
+  S21Matrix expected = CofactorsByMinors(A);
+  S21Matrix result = A.CalcComplements();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ASSERT_NEAR(result(i, j), expected(i, j), 1e-9);
+    }
+  }
+  // После округления ведущий элемент может оказаться не точным нулем, но
+  // он не больше порога n * eps * max|a_ij|, и обращение отказывает при
+  // любом уровне оптимизации
+  double scale = 0;
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      scale = std::max(scale, std::fabs(A(i, j)));
+    }
+  }
+  ASSERT_LE(S21LU(A).MinPivot(),
+            5 * std::numeric_limits<double>::epsilon() * scale);
+  ASSERT_THROW(A.InverseMatrix(), std::invalid_argument);
+
+  // Ранг n - 2: все миноры порядка n - 1 нулевые
+  for (int j = 0; j < 5; j++) {
+    A(3, j) = A(0, j) + A(2, j);
+  }
+  result = A.CalcComplements();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ASSERT_NEAR(result(i, j), 0, 1e-9);
+    }
+  }
+}
+
+TEST(Test_Inverse, complements_of_regular_matrix_with_tiny_pivot) {
+  // [[d, 1], [-d, 1]] + I3: ранг 5, но ведущий элемент частичного
+  // выбора d меньше порога 5 * eps
+  const double d = 0.9 * 5 * std::numeric_limits<double>::epsilon();
+  S21Matrix A(5, 5);
+  A(0, 0) = d;
+  A(0, 1) = 1;
+  A(1, 0) = -d;
+  A(1, 1) = 1;
+  for (int i = 2; i < 5; i++) {
+    A(i, i) = 1;
+  }
+  S21Matrix expected = CofactorsByMinors(A);
+  S21Matrix result = A.CalcComplements();
+  ASSERT_NEAR(result(0, 0), 1, 1e-12);
+  ASSERT_NEAR(result(1, 0), -1, 1e-12);
+  ASSERT_NEAR(result(2, 2) / (2 * d), 1, 1e-12);
+  ASSERT_NEAR(result(1, 1) / d, 1, 1e-12);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ASSERT_NEAR(result(i, j), expected(i, j),
+                  1e-12 * std::fabs(expected(i, j)))
+          << i << " " << j;
+    }
+  }
+}
+
+TEST(Test_Expr, chain_matches_eager) {
+  S21Matrix A(13, 21);
+  S21Matrix B(13, 21);
+  S21Matrix C(13, 21);
+  FillMatrix(A, 20);
+  FillMatrix(B, 21);
+  FillMatrix(C, 22);
+
+  S21Matrix expected(A);
+  expected.SumMatrix(B);
+  S21Matrix scaled(C);
+  scaled.MulNumber(2.0);
+  expected.SubMatrix(scaled);
+
+  S21Matrix result = A + B - C * 2.0;
+  ASSERT_TRUE(result == expected);
+  ASSERT_TRUE(A + B - 2.0 * C == expected);
+  for (int i = 0; i < 13; i++) {
+    for (int j = 0; j < 21; j++) {
+      ASSERT_DOUBLE_EQ(result(i, j), A(i, j) + B(i, j) - C(i, j) * 2.0);
+    }
+  }
+
+  // Произведение выражений вычисляет операнды и вызывает умножение
+  S21Matrix D(21, 5);
+  FillMatrix(D, 23);
+  ASSERT_TRUE((A + B) * D == A * D + B * D);
+  ASSERT_ANY_THROW(A + D);
+  ASSERT_ANY_THROW(A - D * 3.0);
+}
+
+TEST(Test_Expr, auto_results_stay_valid) {
+  S21Matrix A(9, 7);
+  S21Matrix B(9, 7);
+  FillMatrix(A, 23);
+  FillMatrix(B, 24);
+
+  // Узел над переменными: элементы читаются как у матрицы
+  auto sum = A + B;
+  auto scaled = A * 2.0;
+  ASSERT_EQ(sum(2, 3), A(2, 3) + B(2, 3));
+  ASSERT_EQ(scaled(8, 6), A(8, 6) * 2.0);
+  ASSERT_THROW(sum(9, 0), std::out_of_range);
+  ASSERT_THROW(scaled(0, -1), std::out_of_range);
+
+  // С временной матрицей результат считается сразу: auto — это
+  // матрица, а не узел со ссылкой на уничтоженный операнд
+  auto left = S21Matrix(A) + B;
+  auto right = B - S21Matrix(A);
+  auto product = S21Matrix(A) * 3.0;
+  auto chain = (S21Matrix(A) + B) * 2.0 - A;
+  static_assert(std::is_same_v<decltype(left), S21Matrix>);
+  static_assert(std::is_same_v<decltype(right), S21Matrix>);
+  static_assert(std::is_same_v<decltype(product), S21Matrix>);
+  static_assert(std::is_same_v<decltype(chain), S21Matrix>);
+  // Память временных операндов переиспользуется другими матрицами
+  S21Matrix noise(9, 7);
+  FillMatrix(noise, 25);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 7; j++) {
+      ASSERT_EQ(left(i, j), A(i, j) + B(i, j));
+      ASSERT_EQ(right(i, j), B(i, j) - A(i, j));
+      ASSERT_EQ(product(i, j), A(i, j) * 3.0);
+      ASSERT_EQ(chain(i, j), (A(i, j) + B(i, j)) * 2.0 - A(i, j));
+    }
+  }
+}
+
+TEST(Test_Expr, assignment_reuses_and_aliases) {
+  S21Matrix A(9, 9);
+  S21Matrix B(9, 9);
+  FillMatrix(A, 24);
+  FillMatrix(B, 25);
+  S21Matrix expected = (A + B) * 0.5 - B;
+
+  // Операнд совпадает с результатом: буфер переиспользуется
+  const double *buffer = A.data();
+  A = (A + B) * 0.5 - B;
+  ASSERT_EQ(A.data(), buffer);
+  ASSERT_TRUE(A == expected);
+
+  A += B * 2.0;
+  expected.SumMatrix(B);
+  expected.SumMatrix(B);
+  ASSERT_TRUE(A == expected);
+  A -= A - B;
+  ASSERT_TRUE(A == B);
+
+  // Другой размер: матрица пересоздается
+  S21Matrix C(2, 3);
+  C = A * 3.0;
+  ASSERT_EQ(C.GetRows(), 9);
+  ASSERT_EQ(C.GetCols(), 9);
+  ASSERT_DOUBLE_EQ(C(4, 7), 3.0 * B(4, 7));
+}
+
+// Счетчик выделений выровненной памяти: через эту форму operator new
+// выделяются буферы S21Matrix
+std::atomic<int> g_aligned_allocations{0};
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  ++g_aligned_allocations;
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+  void *ptr = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+// Оценка погрешности Винограда (см. s21_matrix_gemm.h) для размера n и
+// точки перехода n0 при max|A| = max|B| = 1
+double StrassenErrorBound(int n, int n0) {
+  const double levels = std::pow(static_cast<double>(n) / n0, std::log2(18.0));
+  return (levels * (n0 * n0 + 6.0 * n0) - 6.0 * n) * DBL_EPSILON / 2;
+}
+
+TEST(Test_Strassen, matches_classic_within_bound) {
+  const int saved = S21GetStrassenCrossover();
+  S21SetStrassenCrossover(16);
+  const int sizes[][3] = {{128, 128, 128}, {203, 97, 151}, {65, 255, 131}};
+  for (const auto &size : sizes) {
+    const int m = size[0];
+    const int k = size[1];
+    const int n = size[2];
+    S21Matrix A(m, k);
+    S21Matrix B(k, n);
+    FillMatrix(A, m);
+    FillMatrix(B, n);
+    S21Matrix classic(A);
+    classic.MulMatrix(B, S21MulAlgorithm::kClassic);
+    S21Matrix strassen(A);
+    strassen.MulMatrix(B, S21MulAlgorithm::kStrassen);
+
+    const int dim = std::max({m, n, k});
+    const double bound = StrassenErrorBound(dim, 16);
+    double max_error = 0;
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        max_error =
+            std::max(max_error, std::fabs(strassen(i, j) - classic(i, j)));
+      }
+    }
+    ASSERT_LE(max_error, bound);
+    ASSERT_GT(S21StrassenWorkspaceSize(m, n, k), 0u);
+  }
+  S21SetStrassenCrossover(saved);
+  ASSERT_ANY_THROW(S21SetStrassenCrossover(8));
+}
+
+TEST(Test_Strassen, auto_selection_and_workspace) {
+  const int saved_crossover = S21GetStrassenCrossover();
+  const int saved_threshold = S21GetStrassenThreshold();
+  S21SetStrassenCrossover(16);
+  S21Matrix A(100, 100);
+  S21Matrix B(100, 100);
+  FillMatrix(A, 30);
+  FillMatrix(B, 31);
+  S21Matrix classic(A);
+  classic.MulMatrix(B, S21MulAlgorithm::kClassic);
+
+  // Порог ниже размера: operator* выбирает Штрассена и сам выделяет
+  // рабочую память одним блоком
+  S21SetStrassenThreshold(64);
+  int before = g_aligned_allocations;
+  S21Matrix product = A * B;
+  ASSERT_EQ(g_aligned_allocations - before, 2);
+  ASSERT_TRUE(product == classic);
+
+  // С буфером вызывающего память не выделяется вовсе
+  std::vector<double> workspace(S21StrassenWorkspaceSize(100, 100, 100));
+  before = g_aligned_allocations;
+  S21GemmStrassen(100, 100, 100, A.data(), A.GetStride(), B.data(),
+                  B.GetStride(), product.data(), product.GetStride(),
+                  workspace.data());
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_TRUE(product == classic);
+
+  S21SetStrassenThreshold(saved_threshold);
+  S21SetStrassenCrossover(saved_crossover);
+}
+
+TEST(Test_Alloc, chains_allocate_once) {
+  // Малые матрицы: произведение считается без буферов упаковки
+  S21Matrix A(7, 7);
+  S21Matrix B(7, 7);
+  S21Matrix C(7, 7);
+  S21Matrix D(7, 7);
+  FillMatrix(A, 26);
+  FillMatrix(B, 27);
+  FillMatrix(C, 28);
+  FillMatrix(D, 29);
+  S21Matrix AB = A * B;
+  S21Matrix CD = C * D;
+
+  int before = g_aligned_allocations;
+  S21Matrix sum = A + B - C * 2.0 + 0.5 * D;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+
+  before = g_aligned_allocations;
+  S21Matrix product_sum = A * B + C - D * 0.5;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(product_sum == AB + C - D * 0.5);
+
+  before = g_aligned_allocations;
+  S21Matrix scaled = C - 2.0 * (A * B) * 3.0;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(scaled == C - AB * 6.0);
+
+  // Два произведения — два буфера; сумма пишется в первый из них
+  before = g_aligned_allocations;
+  S21Matrix products = A * B - C * D;
+  ASSERT_EQ(g_aligned_allocations - before, 2);
+  ASSERT_TRUE(products == AB - CD);
+
+  // Присваивание в матрицу того же размера не выделяет память
+  before = g_aligned_allocations;
+  sum = A - B + C;
+  sum = (A * B) + sum;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(sum == AB + A - B + C);
+}
+
+TEST(Test_Generic, float_matches_naive_on_every_isa) {
+  const S21Isa saved = S21GetActiveIsa();
+  S21MatrixF A(37, 29);
+  S21MatrixF B(29, 41);
+  S21MatrixF C(37, 29);
+  FillMatrix(A, 30);
+  FillMatrix(B, 31);
+  FillMatrix(C, 32);
+  S21MatrixF expected(37, 41);
+  S21GemmNaive(37, 41, 29, A.data(), A.GetStride(), B.data(), B.GetStride(),
+               expected.data(), expected.GetStride());
+  S21SetActiveIsa(S21Isa::kScalar);
+  S21MatrixF chain = A - C * 2.0f;
+  for (S21Isa isa : SupportedIsas()) {
+    S21SetActiveIsa(isa);
+    ASSERT_EQ(S21GetKernels<float>().isa, isa);
+    S21MatrixF product = A * B;
+    ASSERT_TRUE(product == expected) << S21GetKernels<float>().name;
+    S21MatrixF difference(A);
+    difference -= C * 2.0f;
+    ASSERT_TRUE(difference == chain) << S21GetKernels<float>().name;
+  }
+  S21SetActiveIsa(saved);
+
+  // Строка float занимает вдвое больше элементов на кэш-линию
+  ASSERT_EQ(A.GetStride() % 16, 0);
+  ASSERT_EQ(S21MatrixF(2, 17).GetStride(), 32);
+}
+
+TEST(Test_Generic, tolerance_follows_element_type) {
+  S21MatrixF F(2, 2);
+  S21MatrixF G(2, 2);
+  G(1, 1) = 5e-5f;
+  ASSERT_TRUE(F == G);
+  G(1, 1) = 5e-4f;
+  ASSERT_FALSE(F == G);
+
+  S21MatrixLD L(2, 2);
+  S21MatrixLD M(2, 2);
+  M(0, 0) = 1e-8L;
+  ASSERT_FALSE(L == M);
+  M(0, 0) = 1e-10L;
+  ASSERT_TRUE(L == M);
+
+  S21MatrixI I(2, 2);
+  S21MatrixI J(2, 2);
+  J(0, 1) = 1;
+  ASSERT_FALSE(I == J);
+  J(0, 1) = 0;
+  ASSERT_TRUE(I == J);
+}
+
+TEST(Test_Generic, integer_determinant_and_inverse_are_exact) {
+  // Унимодулярная матрица: произведение треугольных с единицами на
+  // диагонали, поэтому определитель равен 1, а обратная целая
+  S21MatrixI64 lower(6, 6);
+  S21MatrixI64 upper(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      if (i == j) {
+        lower(i, j) = 1;
+        upper(i, j) = 1;
+      } else if (i > j) {
+        lower(i, j) = (i * 7 + j * 3) % 5 - 2;
+      } else {
+        upper(i, j) = (i * 5 + j * 11) % 7 - 3;
+      }
+    }
+  }
+  S21MatrixI64 A = lower * upper;
+  ASSERT_EQ(A.Determinant(), 1);
+  S21MatrixI64 inverse = A.InverseMatrix();
+  S21MatrixI64 identity(6, 6);
+  for (int i = 0; i < 6; i++) {
+    identity(i, i) = 1;
+  }
+  ASSERT_TRUE(A * inverse == identity);
+  ASSERT_TRUE(inverse * A == identity);
+
+  // Первый ведущий элемент нулевой: нужна перестановка строк
+  S21MatrixI64 B(4, 4);
+  const std::int64_t values[4][4] = {
+      {0, 2, 1, 3}, {4, 1, 0, 2}, {3, 5, 7, 1}, {2, 0, 6, 4}};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      B(i, j) = values[i][j];
+    }
+  }
+  ASSERT_EQ(B.Determinant(), -490);
+  ASSERT_ANY_THROW(B.InverseMatrix());
+  // A * adj(A) = det(A) * E
+  S21MatrixI64 scaled_identity(4, 4);
+  for (int i = 0; i < 4; i++) {
+    scaled_identity(i, i) = -490;
+  }
+  ASSERT_TRUE(B * B.CalcComplements().Transpose() == scaled_identity);
+
+  S21MatrixI singular(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      singular(i, j) = i + j;
+    }
+  }
+  ASSERT_EQ(singular.Determinant(), 0);
+  ASSERT_ANY_THROW(singular.InverseMatrix());
+}
+
+TEST(Test_Generic, long_double_uses_lu) {
+  S21MatrixLD A(8, 8);
+  FillMatrix(A, 33);
+  for (int i = 0; i < 8; i++) {
+    A(i, i) += 4;
+  }
+  S21MatrixLD product = A * A.InverseMatrix();
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) {
+      ASSERT_NEAR(static_cast<double>(product(i, j)), i == j ? 1.0 : 0.0,
+                  1e-15);
+    }
+  }
+  ASSERT_NEAR(static_cast<double>(A.Determinant()),
+              static_cast<double>(S21BasicLU<long double>(A).Determinant()),
+              1e-9);
+}
+
+// Можно ли перемножить матрицы типов A и B (проверка во время компиляции)
+template <typename A, typename B, typename = void>
+struct CanMultiply : std::false_type {};
+
+template <typename A, typename B>
+struct CanMultiply<A, B,
+                   std::void_t<decltype(std::declval<const A &>() *
+                                        std::declval<const B &>())>>
+    : std::true_type {};
+
+// Считаются во время компиляции
+constexpr S21FixedMatrix<3, 3> kRotation({0, -1, 0, 1, 0, 0, 0, 0, 1});
+constexpr S21FixedMatrix<4, 4> kTransform({2, 0, 0, 1, 0, 1, 3, 0, 0, 0, 4,
+                                           5, 0, 0, 0, 1});
+static_assert(kRotation.Determinant() == 1);
+static_assert(kTransform.Determinant() == 8);
+static_assert((kRotation * kRotation.Transpose()) ==
+              S21FixedMatrix<3, 3>::Identity());
+static_assert(kTransform * kTransform.InverseMatrix() ==
+              S21FixedMatrix<4, 4>::Identity());
+static_assert(sizeof(S21FixedMatrix<4, 4, float>) == 16 * sizeof(float));
+static_assert(CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 5>>::value);
+static_assert(!CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>::value);
+static_assert(std::is_same_v<decltype(S21FixedMatrix<2, 3>() *
+                                      S21FixedMatrix<3, 5>()),
+                             S21FixedMatrix<2, 5>>);
+
+// Проверяет, что операции фиксированной матрицы порядка N совпадают с
+// операциями динамической
+template <int N>
+void CheckFixedAgainstDynamic(unsigned seed) {
+  S21Matrix dynamic(N, N);
+  FillMatrix(dynamic, seed);
+  for (int i = 0; i < N; i++) {
+    dynamic(i, i) += 2;
+  }
+  const S21FixedMatrix<N, N> fixed(dynamic);
+  ASSERT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-9) << N;
+  ASSERT_TRUE(S21Matrix(fixed.InverseMatrix()) == dynamic.InverseMatrix())
+      << N;
+  ASSERT_TRUE(S21Matrix(fixed.CalcComplements()) == dynamic.CalcComplements())
+      << N;
+  ASSERT_TRUE(S21Matrix(fixed * fixed) == dynamic * dynamic) << N;
+  ASSERT_TRUE(S21Matrix(fixed.Transpose()) == dynamic.Transpose()) << N;
+}
+
+TEST(Test_Fixed, matches_dynamic_matrix) {
+  // Динамическая матрица 1x1 не считает дополнения через миноры 0x0
+  constexpr S21FixedMatrix<1, 1> kOne({4});
+  static_assert(kOne.Determinant() == 4);
+  static_assert(kOne.InverseMatrix()(0, 0) == 0.25);
+  static_assert(kOne.CalcComplements()(0, 0) == 1);
+  CheckFixedAgainstDynamic<2>(41);
+  CheckFixedAgainstDynamic<3>(42);
+  CheckFixedAgainstDynamic<4>(43);
+  CheckFixedAgainstDynamic<6>(44);
+}
+
+TEST(Test_Fixed, arithmetic_and_conversion) {
+  S21FixedMatrix<2, 3> A({1, 2, 3, 4, 5, 6});
+  S21FixedMatrix<2, 3> B({6, 5, 4});
+  ASSERT_EQ(B(1, 2), 0);
+  S21FixedMatrix<2, 3> C = A + B * 2.0 - 0.5 * A;
+  ASSERT_EQ(C(0, 0), 12.5);
+  ASSERT_EQ(C(1, 2), 3);
+  C -= A;
+  C += B;
+  C *= 2.0;
+  ASSERT_EQ(C(0, 1), 2 * (2 + 10 - 1 - 2 + 5));
+
+  S21FixedMatrix<3, 3> M = S21FixedMatrix<3, 3>::Identity() * 3.0;
+  S21FixedMatrix<2, 3> product = A;
+  product *= M;
+  ASSERT_TRUE(product == A * 3.0);
+
+  // Преобразования в обе стороны; размер динамической проверяется
+  S21Matrix dynamic(A);
+  ASSERT_EQ(dynamic.GetRows(), 2);
+  ASSERT_EQ(dynamic.GetCols(), 3);
+  ASSERT_EQ(dynamic(1, 2), 6);
+  using Fixed32 = S21FixedMatrix<3, 2>;
+  ASSERT_TRUE(decltype(A)(dynamic) == A);
+  ASSERT_THROW(Fixed32{dynamic}, std::invalid_argument);
+
+  S21FixedMatrix<3, 3> singular({1, 2, 3, 2, 4, 6, 0, 1, 1});
+  ASSERT_EQ(singular.Determinant(), 0);
+  ASSERT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  S21FixedMatrix<5, 5> singular5;
+  ASSERT_THROW(singular5.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(Test_Fixed, integer_matrices_are_exact) {
+  using Fixed4 = S21FixedMatrix<4, 4, int>;
+  Fixed4 A({1, 2, 0, 0, 0, 1, 3, 0, 0, 0, 1, 4, 5, 0, 0, 1});
+  // Определитель 1 + 5 * (-1)^3 * 2 * 3 * 4 = -119: обратная не целая
+  ASSERT_EQ(A.Determinant(), -119);
+  ASSERT_THROW(A.InverseMatrix(), std::invalid_argument);
+  ASSERT_TRUE(A * A.CalcComplements().Transpose() ==
+              Fixed4::Identity() * -119);
+
+  using Fixed5 = S21FixedMatrix<5, 5, std::int64_t>;
+  Fixed5 U = Fixed5::Identity();
+  for (int i = 0; i < 5; i++) {
+    for (int j = i + 1; j < 5; j++) {
+      U(i, j) = i - j;
+    }
+  }
+  const Fixed5 LU = U.Transpose() * U;
+  ASSERT_EQ(LU.Determinant(), 1);
+  ASSERT_TRUE(LU * LU.InverseMatrix() == Fixed5::Identity());
+}
+
+TEST(Test_View, blocks_write_through) {
+  S21Matrix M(6, 7);
+  FillMatrix(M, 50);
+  const S21Matrix original(M);
+
+  S21MatrixView top_left = S21MatrixView(M).Block(0, 0, 3, 3);
+  S21ConstMatrixView bottom_right = S21ConstMatrixView(M).Block(3, 4, 3, 3);
+  ASSERT_EQ(top_left.GetRows(), 3);
+  ASSERT_TRUE(top_left.IsDense());
+  ASSERT_EQ(&bottom_right(0, 0), &M(3, 4));
+  ASSERT_EQ(bottom_right.Block(1, 1, 2, 2)(1, 0), M(5, 5));
+  ASSERT_THROW(top_left.Block(1, 1, 3, 1), std::out_of_range);
+  ASSERT_THROW(top_left(3, 0), std::out_of_range);
+
+  // Арифметика над видами пишет прямо в матрицу и не выделяет память
+  int before = g_aligned_allocations;
+  top_left += bottom_right * 2.0;
+  top_left -= bottom_right;
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 7; j++) {
+      const double expected =
+          i < 3 && j < 3 ? original(i, j) + original(i + 3, j + 4)
+                         : original(i, j);
+      ASSERT_DOUBLE_EQ(M(i, j), expected);
+    }
+  }
+
+  // Копирование между видами копирует элементы
+  S21MatrixView(M).Block(3, 0, 3, 3) = top_left;
+  ASSERT_EQ(M(4, 1), M(1, 1));
+  S21Matrix copy = bottom_right - top_left;
+  ASSERT_EQ(copy.GetRows(), 3);
+  ASSERT_TRUE(copy + top_left == bottom_right);
+}
+
+TEST(Test_View, minors_and_transpose) {
+  S21Matrix M(4, 5);
+  FillMatrix(M, 51);
+  const S21ConstMatrixView view(M);
+
+  S21ConstMatrixView minor = view.Minor(1, 2);
+  ASSERT_EQ(minor.GetRows(), 3);
+  ASSERT_EQ(minor.GetCols(), 4);
+  ASSERT_FALSE(minor.IsDense());
+  ASSERT_EQ(minor(0, 1), M(0, 1));
+  ASSERT_EQ(minor(1, 2), M(2, 3));
+  ASSERT_EQ(minor.Block(1, 1, 2, 2)(0, 1), M(2, 3));
+  ASSERT_THROW(minor.Minor(0, 0), std::invalid_argument);
+
+  S21ConstMatrixView transposed = view.Transpose();
+  ASSERT_EQ(transposed.GetRows(), 5);
+  ASSERT_TRUE(transposed == M.Transpose());
+  ASSERT_EQ(transposed.Minor(4, 0)(0, 1), M(2, 0));
+  S21Matrix T = transposed.Block(1, 0, 3, 4) * 2.0;
+  ASSERT_EQ(T(2, 3), 2 * M(3, 3));
+
+  // Определитель минора по виду совпадает с определителем копии
+  S21Matrix square(5, 5);
+  FillMatrix(square, 52);
+  for (int size = 1; size <= 5; size++) {
+    S21ConstMatrixView block = S21ConstMatrixView(square).Block(0, 0, size,
+                                                                size);
+    S21Matrix copy(block);
+    ASSERT_NEAR(block.Determinant(), copy.Determinant(), 1e-12);
+    if (size > 1) {
+      S21Matrix minor_copy(block.Minor(size - 1, 0));
+      ASSERT_NEAR(block.Minor(size - 1, 0).Determinant(),
+                  minor_copy.Determinant(), 1e-12);
+    }
+  }
+
+  // Дополнения считаются по видам-минорам: память — только под результат
+  S21Matrix A(3, 3);
+  FillMatrix(A, 53);
+  int before = g_aligned_allocations;
+  S21Matrix complements = A.CalcComplements();
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(complements.Transpose() * A * (1.0 / A.Determinant()) ==
+              S21Matrix(S21FixedMatrix<3, 3>::Identity()));
+
+  // Минор матрицы 1x1 пустой, его определитель равен 1
+  S21Matrix one(1, 1);
+  one(0, 0) = 4;
+  ASSERT_EQ(one.CalcComplements()(0, 0), 1);
+  ASSERT_EQ(one.InverseMatrix()(0, 0), 0.25);
+}
+
+TEST(Test_View, multiplication_in_place) {
+  S21Matrix A(9, 8);
+  S21Matrix B(8, 10);
+  FillMatrix(A, 54);
+  FillMatrix(B, 55);
+  S21Matrix C(12, 12);
+  S21ConstMatrixView a = S21ConstMatrixView(A).Block(1, 2, 5, 6);
+  S21ConstMatrixView b = S21ConstMatrixView(B).Block(2, 3, 6, 4);
+  S21MatrixView c = S21MatrixView(C).Block(4, 5, 5, 4);
+  S21Matrix expected = S21Matrix(a) * S21Matrix(b);
+
+  int before = g_aligned_allocations;
+  S21MulViews(a, b, c);
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_TRUE(c == expected);
+  ASSERT_EQ(C(3, 5), 0);
+  S21MulViews(a, b, c, true);
+  ASSERT_TRUE(c == expected * 2.0);
+
+  // Транспонированные операнды и результат передаются в S21Gemm флагами
+  S21Matrix product(4, 5);
+  const S21Matrix expected_t = expected.Transpose();
+  before = g_aligned_allocations;
+  S21MulViews(b.Transpose(), a.Transpose(), S21MatrixView(product));
+  ASSERT_TRUE(product == expected_t);
+  S21MulViews(a, b, c.Transpose().Transpose());
+  S21MulViews(b.Transpose(), a.Transpose(), S21MatrixView(C).Transpose()
+                                                .Block(5, 4, 4, 5));
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_TRUE(c == expected);
+  ASSERT_THROW(S21MulViews(a, a, c), std::invalid_argument);
+  ASSERT_THROW(S21MulViews(a, b, c.Block(0, 0, 4, 4)), std::invalid_argument);
+}
+
+// Разреженная матрица rows x cols: примерно каждый step-й элемент
+// ненулевой
+S21Matrix SparseFill(int rows, int cols, int step, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      if (gen() % step == 0) {
+        result(i, j) = dist(gen);
+      }
+    }
+  }
+  return result;
+}
+
+TEST(Test_Sparse, triplets_and_conversions) {
+  // Повторы складываются, взаимно уничтожившиеся не хранятся
+  const std::vector<S21Triplet<double>> triplets = {
+      {2, 1, 4.0}, {0, 3, 1.5}, {2, 1, -1.0}, {1, 0, 2.0},
+      {0, 0, -3.0}, {1, 2, 5.0}, {1, 2, -5.0}};
+  for (S21SparseFormat format : {S21SparseFormat::kCsr,
+                                 S21SparseFormat::kCsc}) {
+    S21SparseMatrix S = S21SparseMatrix::FromTriplets(3, 4, triplets, format);
+    ASSERT_EQ(S.NonZeros(), 4);
+    ASSERT_EQ(S.GetFormat(), format);
+    S21Matrix D = S.ToDense();
+    ASSERT_EQ(D(0, 0), -3.0);
+    ASSERT_EQ(D(0, 3), 1.5);
+    ASSERT_EQ(D(1, 0), 2.0);
+    ASSERT_EQ(D(2, 1), 3.0);
+    ASSERT_EQ(D(1, 2), 0.0);
+    ASSERT_EQ(S(2, 1), 3.0);
+    ASSERT_EQ(S(2, 2), 0.0);
+    ASSERT_TRUE(S21SparseMatrix(D, format).ToDense() == D);
+    ASSERT_TRUE(S.ToFormat(S21SparseFormat::kCsr).ToDense() == D);
+    ASSERT_TRUE(S.ToFormat(S21SparseFormat::kCsc).ToDense() == D);
+    ASSERT_TRUE(S.Transpose().ToDense() == D.Transpose());
+    // Временная матрица отдает массивы без копирования
+    S21SparseMatrix copy(S);
+    const double *values = copy.GetValues().data();
+    S21SparseMatrix T = std::move(copy).Transpose();
+    ASSERT_EQ(T.GetValues().data(), values);
+    ASSERT_NE(T.GetFormat(), format);
+    ASSERT_TRUE(T.ToDense() == D.Transpose());
+    ASSERT_THROW(S(3, 0), std::out_of_range);
+  }
+  const std::vector<int> offsets = {0, 2, 3, 4};
+  const std::vector<int> indices = {0, 3, 0, 1};
+  S21SparseMatrix S = S21SparseMatrix::FromTriplets(3, 4, triplets);
+  ASSERT_EQ(S.GetOffsets(), offsets);
+  ASSERT_EQ(S.GetIndices(), indices);
+  ASSERT_THROW(S21SparseMatrix::FromTriplets(3, 4, {{0, 4, 1.0}}),
+               std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(0, 4), std::invalid_argument);
+
+  // Малые по модулю элементы отбрасываются
+  S21Matrix D(2, 2);
+  D(0, 0) = 1e-12;
+  D(1, 1) = 1.0;
+  ASSERT_EQ(S21SparseMatrix(D, S21SparseFormat::kCsr, 1e-9).NonZeros(), 1);
+}
+
+TEST(Test_Sparse, products_match_dense) {
+  const int saved_threads = S21GetThreadCount();
+  const long long saved_cutoff = S21GetParallelCutoff();
+  S21Matrix A = SparseFill(97, 61, 7, 20);
+  S21Matrix B = SparseFill(61, 45, 5, 21);
+  S21Matrix X(61, 13);
+  FillMatrix(X, 22);
+  std::vector<double> x(61);
+  for (int j = 0; j < 61; j++) {
+    x[j] = X(j, 0);
+  }
+  S21Matrix AB = A * B;
+  S21Matrix AX = A * X;
+  std::vector<double> Ax(97, 0.0);
+  for (int i = 0; i < 97; i++) {
+    for (int j = 0; j < 61; j++) {
+      Ax[i] += A(i, j) * x[j];
+    }
+  }
+
+  // Последовательно и параллельно, в обоих форматах
+  for (int threads : {1, 4}) {
+    S21SetThreadCount(threads);
+    S21SetParallelCutoff(threads == 1 ? saved_cutoff : 0);
+    for (S21SparseFormat format : {S21SparseFormat::kCsr,
+                                   S21SparseFormat::kCsc}) {
+      S21SparseMatrix SA(A, format);
+      S21SparseMatrix SB(B, S21SparseFormat::kCsc);
+      std::vector<double> y = SA * x;
+      ASSERT_EQ(y.size(), Ax.size());
+      for (int i = 0; i < 97; i++) {
+        ASSERT_NEAR(y[i], Ax[i], 1e-12);
+      }
+      ASSERT_TRUE((SA * X) == AX);
+      S21SparseMatrix SAB = SA * SB;
+      ASSERT_EQ(SAB.GetFormat(), format);
+      ASSERT_TRUE(SAB.ToDense() == AB);
+    }
+  }
+  S21SetThreadCount(saved_threads);
+  S21SetParallelCutoff(saved_cutoff);
+
+  S21SparseMatrix SA(A);
+  ASSERT_THROW(SA * std::vector<double>(60), std::invalid_argument);
+  ASSERT_THROW(SA * S21Matrix(60, 2), std::invalid_argument);
+  ASSERT_THROW(SA * S21SparseMatrix(60, 2), std::invalid_argument);
+}
+
+TEST(Test_Sparse, memory_scales_with_nonzeros) {
+  // Плотная матрица такого размера заняла бы 80 ГБ
+  const int n = 100000;
+  std::vector<S21Triplet<double>> triplets;
+  for (int i = 0; i < n; i += 3) {
+    triplets.push_back({i, (i * 7) % n, 2.0});
+  }
+  S21SparseMatrix S = S21SparseMatrix::FromTriplets(n, n, triplets);
+  ASSERT_EQ(S.NonZeros(), static_cast<int>(triplets.size()));
+  S21SparseMatrix S2 = S * S.Transpose();
+  ASSERT_EQ(S2.NonZeros(), S.NonZeros());
+  ASSERT_EQ(S2(3, 3), 4.0);
+  std::vector<double> y = S * std::vector<double>(n, 1.0);
+  ASSERT_EQ(y[0], 2.0);
+  ASSERT_EQ(y[1], 0.0);
+}
+
+TEST(Test_Batch, matches_individual_matrices) {
+  const S21Isa saved = S21GetActiveIsa();
+  // 37 матриц: векторные группы и хвост на любом наборе инструкций;
+  // порядок 5 считается по одной матрице
+  const int count = 37;
+  for (int n = 1; n <= 5; n++) {
+    S21MatrixBatch A(count, n, n);
+    S21MatrixBatch B(count, n, n);
+    for (int l = 0; l < count; l++) {
+      S21Matrix a(n, n);
+      S21Matrix b(n, n);
+      FillMatrix(a, 100 + l);
+      FillMatrix(b, 200 + l);
+      A.Set(l, a);
+      B.Set(l, b);
+    }
+    for (S21Isa isa : SupportedIsas()) {
+      S21SetActiveIsa(isa);
+      S21MatrixBatch sum = A + B;
+      S21MatrixBatch diff = A - B;
+      S21MatrixBatch scaled = A * 2.5;
+      S21MatrixBatch product = A * B;
+      S21MatrixBatch inverse = A.InverseMatrix();
+      std::vector<double> det = A.Determinant();
+      ASSERT_EQ(static_cast<int>(det.size()), count);
+      for (int l = 0; l < count; l++) {
+        S21Matrix a = A.Get(l);
+        S21Matrix b = B.Get(l);
+        ASSERT_TRUE(sum.Get(l) == a + b) << S21GetKernels().name;
+        ASSERT_TRUE(diff.Get(l) == a - b) << S21GetKernels().name;
+        ASSERT_TRUE(scaled.Get(l) == a * 2.5) << S21GetKernels().name;
+        ASSERT_TRUE(product.Get(l) == a * b) << S21GetKernels().name;
+        ASSERT_TRUE(inverse.Get(l) == a.InverseMatrix())
+            << S21GetKernels().name << " n = " << n << " l = " << l;
+        ASSERT_NEAR(det[l], a.Determinant(), 1e-12) << S21GetKernels().name;
+      }
+    }
+  }
+  S21SetActiveIsa(saved);
+
+  // Прямоугольные матрицы и составное присваивание
+  S21MatrixBatchF C(19, 2, 3);
+  S21MatrixBatchF D(19, 3, 4);
+  C(7, 1, 2) = 2.0f;
+  D(7, 2, 3) = 1.5f;
+  C *= D;
+  ASSERT_EQ(C.GetCols(), 4);
+  ASSERT_EQ(C(7, 1, 3), 3.0f);
+  ASSERT_EQ(C(6, 1, 3), 0.0f);
+  ASSERT_EQ(C.Plane(1, 3)[7], 3.0f);
+  ASSERT_EQ(C.GetStride() % 16, 0);
+
+  // Каждая плоскость начинается на границе 64 байт, и в копии тоже
+  const S21MatrixBatchF copy(C);
+  for (int i = 0; i < C.GetRows(); i++) {
+    for (int j = 0; j < C.GetCols(); j++) {
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(C.Plane(i, j)) % 64, 0u);
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(copy.Plane(i, j)) % 64, 0u);
+    }
+  }
+  ASSERT_TRUE(copy == C);
+}
+
+TEST(Test_Batch, errors) {
+  S21MatrixBatch A(5, 3, 3);
+  for (int l = 0; l < 5; l++) {
+    for (int i = 0; i < 3; i++) {
+      A(l, i, i) = l + 1;
+    }
+  }
+  S21MatrixBatch B(A);
+  ASSERT_TRUE(A == B);
+  B(4, 0, 1) = 1e-3;
+  ASSERT_FALSE(A == B);
+  ASSERT_FALSE(A == S21MatrixBatch(4, 3, 3));
+  ASSERT_EQ(A.InverseMatrix()(2, 1, 1), 1.0 / 3);
+  A(3, 2, 2) = 0;
+  ASSERT_THROW(A.InverseMatrix(), std::invalid_argument);
+  ASSERT_THROW(A + S21MatrixBatch(4, 3, 3), std::invalid_argument);
+  ASSERT_THROW(A * S21MatrixBatch(5, 2, 3), std::invalid_argument);
+  ASSERT_THROW(S21MatrixBatch(5, 2, 3).Determinant(), std::invalid_argument);
+  ASSERT_THROW(A(5, 0, 0), std::out_of_range);
+  ASSERT_THROW(A.Set(0, S21Matrix(2, 3)), std::invalid_argument);
+  ASSERT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+}
+
+TEST(Test_File, save_and_map) {
+  const std::string path = testing::TempDir() + "s21_matrix_test.bin";
+  S21Matrix A(37, 11);
+  FillMatrix(A, 30);
+  A.SaveFile(path);
+
+  S21MappedMatrix mapped = S21Matrix::MapFile(path);
+  ASSERT_EQ(mapped.GetRows(), 37);
+  ASSERT_EQ(mapped.GetCols(), 11);
+  ASSERT_EQ(mapped.GetStride(), A.GetStride());
+  ASSERT_EQ(mapped.GetMode(), S21MapMode::kReadOnly);
+  // Файл совпадает с памятью матрицы байт в байт
+  ASSERT_EQ(std::memcmp(mapped.data(), A.data(),
+                        sizeof(double) * A.GetRows() * A.GetStride()),
+            0);
+  ASSERT_EQ(mapped(36, 10), A(36, 10));
+  ASSERT_TRUE(S21Matrix(mapped.View()) == A);
+  ASSERT_THROW(mapped(37, 0), std::out_of_range);
+  ASSERT_THROW(mapped.MutableView(), std::logic_error);
+
+  // Изменения копии при записи не попадают в файл
+  S21MappedMatrix private_copy = S21Matrix::MapFile(path,
+                                                    S21MapMode::kCopyOnWrite);
+  S21MatrixView view = private_copy.MutableView();
+  view(0, 0) = 100.0;
+  view.Block(1, 0, 2, 11) *= 2.0;
+  ASSERT_EQ(private_copy(0, 0), 100.0);
+  ASSERT_EQ(private_copy(2, 5), 2.0 * A(2, 5));
+  ASSERT_EQ(mapped(0, 0), A(0, 0));
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(path).View()) == A);
+
+  // Перенос передает отображение
+  S21MappedMatrix moved(std::move(mapped));
+  ASSERT_EQ(moved(5, 5), A(5, 5));
+  std::remove(path.c_str());
+}
+
+TEST(Test_File, matrix_over_mapping) {
+  const std::string path = testing::TempDir() + "s21_matrix_adopt.bin";
+  S21Matrix A(40, 40);
+  FillMatrix(A, 31);
+  for (int i = 0; i < 40; i++) {
+    A(i, i) += 40;
+  }
+  A.SaveFile(path);
+
+  for (S21MapMode mode : {S21MapMode::kReadOnly, S21MapMode::kCopyOnWrite}) {
+    // Матрица забирает отображение без выделения буфера
+    const int before = g_aligned_allocations;
+    S21MappedMatrix mapped = S21Matrix::MapFile(path, mode);
+    const double *pages = mapped.data();
+    S21Matrix M(std::move(mapped));
+    ASSERT_EQ(g_aligned_allocations - before, 0);
+    ASSERT_EQ(static_cast<const S21Matrix &>(M).data(), pages);
+    ASSERT_EQ(mapped.data(), nullptr);
+    ASSERT_TRUE(M.IsCopyOnWrite());
+
+    // Работает весь интерфейс матрицы
+    ASSERT_TRUE(M == A);
+    ASSERT_EQ(M.Determinant(), A.Determinant());
+    ASSERT_TRUE(M.InverseMatrix() == A.InverseMatrix());
+    ASSERT_TRUE(M * A == A * A);
+
+    // Копия разделяет страницы; запись меняет только свою копию и не
+    // попадает в файл
+    S21Matrix copy(M);
+    ASSERT_TRUE(M.IsShared());
+    copy(0, 0) = -1;
+    ASSERT_EQ(M(0, 0), A(0, 0));
+    M(1, 1) = 7;
+    M.MulNumber(2);
+    ASSERT_EQ(M(1, 1), 14);
+    M.SetRows(41);
+    ASSERT_EQ(M(40, 0), 0);
+  }
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(path).View()) == A);
+
+  // Шаг строки в файле больше, чем у матрицы: строки копируются
+  S21MatrixFileHeader header = S21MakeFileHeader<double>(3, 2);
+  header.stride = 16;
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int i = 0; i < 3; i++) {
+      double row[16] = {i + 0.5, -i - 0.5};
+      out.write(reinterpret_cast<const char *>(row), sizeof(row));
+    }
+  }
+  S21Matrix W(S21Matrix::MapFile(path));
+  ASSERT_EQ(W.GetRows(), 3);
+  ASSERT_EQ(W.GetCols(), 2);
+  ASSERT_EQ(W(2, 0), 2.5);
+  ASSERT_EQ(W(2, 1), -2.5);
+  std::remove(path.c_str());
+}
+
+TEST(Test_File, streaming_writer) {
+  const std::string path = testing::TempDir() + "s21_matrix_stream.bin";
+  {
+    S21BasicMatrixWriter<std::int64_t> writer(path, 5, 3);
+    for (std::int64_t i = 0; i < 5; i++) {
+      const std::int64_t row[] = {i, i * i, -i};
+      writer.WriteRow(row);
+    }
+    ASSERT_EQ(writer.GetRowsWritten(), 5);
+    ASSERT_THROW(writer.WriteRow(nullptr), std::out_of_range);
+    writer.Close();
+  }
+  S21BasicMappedMatrix<std::int64_t> mapped = S21MatrixI64::MapFile(path);
+  ASSERT_EQ(mapped(4, 1), 16);
+  ASSERT_EQ(mapped(3, 2), -3);
+  // Файл другого типа не открывается
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+
+  S21MatrixWriter incomplete(path, 4, 4);
+  const double row[4] = {};
+  incomplete.WriteRow(row);
+  ASSERT_THROW(incomplete.Close(), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(Test_File, rejects_bad_files) {
+  const std::string path = testing::TempDir() + "s21_matrix_bad.bin";
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  S21Matrix A(64, 64);
+  A.SaveFile(path);
+  {
+    // Обрезанный файл
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+  }
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << std::string(128, 'x');
+  }
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+
+  // Испорченные поля заголовка: данные внутри заголовка, смещение или
+  // шаг строки не кратны 64 байтам, выравнивание не степень двойки
+  auto corrupt = [&path](int cols, auto change) {
+    S21Matrix M(64, cols);
+    M.SaveFile(path);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    S21MatrixFileHeader header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    change(&header);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  };
+  corrupt(64, [](S21MatrixFileHeader *h) { h->data_offset = 0; });
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  corrupt(64, [](S21MatrixFileHeader *h) { h->data_offset = 32; });
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  corrupt(64, [](S21MatrixFileHeader *h) { h->data_offset = 96; });
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  corrupt(64, [](S21MatrixFileHeader *h) { h->alignment = 96; });
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  corrupt(3, [](S21MatrixFileHeader *h) {
+    h->alignment = 32;
+    h->stride = 4;
+  });
+  ASSERT_THROW(S21Matrix::MapFile(path), std::runtime_error);
+  corrupt(64, [](S21MatrixFileHeader *) {});
+  ASSERT_NO_THROW(S21Matrix::MapFile(path));
+  std::remove(path.c_str());
+}
+
+TEST(Test_OutOfCore, matches_in_memory_product) {
+  const std::string a_path = testing::TempDir() + "s21_ooc_a.bin";
+  const std::string b_path = testing::TempDir() + "s21_ooc_b.bin";
+  const std::string c_path = testing::TempDir() + "s21_ooc_c.bin";
+  // Размеры не кратны плитке: есть неполные плитки по всем трем осям
+  S21Matrix A(150, 70);
+  S21Matrix B(70, 93);
+  FillMatrix(A, 40);
+  FillMatrix(B, 41);
+  A.SaveFile(a_path);
+  B.SaveFile(b_path);
+
+  // Бюджет на плитки 32 x 32 и упаковку блоков 32 x 32 в одном потоке;
+  // запас покрывает округление блоков до регистрового блока
+  const int saved_threads = S21GetThreadCount();
+  S21SetThreadCount(1);
+  const std::size_t budget =
+      5 * 32 * 32 * sizeof(double) + 2 * 32 * 32 * sizeof(double) + 8192;
+  S21OutOfCoreStats stats =
+      S21MultiplyFiles<double>(a_path, b_path, c_path, budget);
+  ASSERT_EQ(stats.tile_rows, 32);
+  ASSERT_EQ(stats.tile_depth, 32);
+  ASSERT_GE(stats.workspace_bytes, 2 * 32 * 32 * sizeof(double));
+  ASSERT_LE(stats.buffer_bytes + stats.workspace_bytes, budget);
+  ASSERT_EQ(stats.tiles_read, 2 * 5 * 3 * 3);
+  S21MappedMatrix C = S21Matrix::MapFile(c_path);
+  ASSERT_EQ(C.GetRows(), 150);
+  ASSERT_EQ(C.GetCols(), 93);
+  ASSERT_TRUE(S21Matrix(C.View()) == A * B);
+
+  // Бюджет больше операндов: одна плитка
+  stats = S21MultiplyFiles<double>(a_path, b_path, c_path, 1 << 20);
+  ASSERT_EQ(stats.tiles_read, 2);
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(c_path).View()) == A * B);
+
+  ASSERT_THROW(S21MultiplyFiles<double>(a_path, b_path, c_path, 1000),
+               std::invalid_argument);
+  ASSERT_THROW(S21MultiplyFiles<double>(a_path, a_path, c_path, budget),
+               std::invalid_argument);
+  ASSERT_THROW(S21MultiplyFiles<float>(a_path, b_path, c_path, budget),
+               std::runtime_error);
+
+  // Упаковка каждого потока входит в бюджет: с четырьмя потоками плитки
+  // меньше, результат тот же
+  S21SetThreadCount(4);
+  stats = S21MultiplyFiles<double>(a_path, b_path, c_path, budget);
+  S21SetThreadCount(saved_threads);
+  ASSERT_LT(stats.tile_rows, 32);
+  ASSERT_LE(stats.buffer_bytes + stats.workspace_bytes, budget);
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(c_path).View()) == A * B);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(Test_OutOfCore, rejects_result_over_operand) {
+  const std::string a_path = testing::TempDir() + "s21_ooc_alias_a.bin";
+  const std::string b_path = testing::TempDir() + "s21_ooc_alias_b.bin";
+  const std::string link_path = testing::TempDir() + "s21_ooc_alias_l.bin";
+  S21Matrix A(20, 20);
+  S21Matrix B(20, 20);
+  FillMatrix(A, 42);
+  FillMatrix(B, 43);
+  A.SaveFile(a_path);
+  B.SaveFile(b_path);
+  ASSERT_EQ(link(b_path.c_str(), link_path.c_str()), 0);
+
+  ASSERT_THROW(S21MultiplyFiles<double>(a_path, b_path, a_path, 1 << 20),
+               std::invalid_argument);
+  ASSERT_THROW(S21MultiplyFiles<double>(a_path, b_path, link_path, 1 << 20),
+               std::invalid_argument);
+  // Другая запись пути к тому же файлу
+  ASSERT_THROW(S21MultiplyFiles<double>(
+                   a_path, b_path, testing::TempDir() + "./s21_ooc_alias_a.bin",
+                   1 << 20),
+               std::invalid_argument);
+  // Операнды не испорчены
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(a_path).View()) == A);
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(b_path).View()) == B);
+
+  // Квадрат матрицы: один файл для обоих операндов допустим
+  ASSERT_NO_THROW(S21MultiplyFiles<double>(a_path, a_path, b_path, 1 << 20));
+  ASSERT_TRUE(S21Matrix(S21Matrix::MapFile(b_path).View()) == A * A);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(link_path.c_str());
+}
+
+TEST(Test_Pool, steady_state_loop_does_not_allocate) {
+  S21Matrix A(40, 40);
+  S21Matrix B(40, 40);
+  FillMatrix(A, 50);
+  FillMatrix(B, 51);
+  const S21Matrix expected = (A + B) * A - B * 2.0;
+
+  S21PoolScope arena;
+  ASSERT_EQ(S21GetAllocator(), &arena.Pool());
+  auto iteration = [&]() {
+    S21Matrix sum = A + B;
+    S21Matrix copy(sum);
+    copy.MulMatrix(A);
+    S21Matrix result = copy - B * 2.0;
+    ASSERT_TRUE(result == expected);
+  };
+  iteration();  // Прогрев: буферы попадают в пул
+  arena.Pool().ResetStats();
+  const S21AllocatorStats system_before = S21SystemAllocator()->GetStats();
+  const int before = g_aligned_allocations;
+  for (int i = 0; i < 10; i++) {
+    iteration();
+  }
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_EQ(S21SystemAllocator()->GetStats().system_allocations,
+            system_before.system_allocations);
+  const S21AllocatorStats stats = arena.Pool().GetStats();
+  ASSERT_GT(stats.allocations, 0);
+  ASSERT_EQ(stats.pool_hits, stats.allocations);
+  ASSERT_EQ(stats.system_allocations, 0);
+  ASSERT_EQ(stats.deallocations, stats.allocations);
+  ASSERT_EQ(stats.bytes, stats.allocations * 40 * 40 * 8);
+}
+
+TEST(Test_Pool, classes_limits_and_ownership) {
+  ASSERT_EQ(S21GetAllocator(), S21SystemAllocator());
+  S21BufferPool pool;
+  {
+    S21AllocatorScope scope(&pool);
+    // 10 x 8 и 9 x 8 — 640 и 576 байт, оба в классе 640 байт
+    { S21Matrix first(10, 8); }
+    S21Matrix second(9, 8);
+    ASSERT_EQ(pool.GetStats().pool_hits, 1);
+    ASSERT_EQ(pool.GetCachedBytes(), 0u);
+
+    // Вложенная область с системным распределителем
+    {
+      S21AllocatorScope inner(nullptr);
+      ASSERT_EQ(S21GetAllocator(), S21SystemAllocator());
+    }
+    ASSERT_EQ(S21GetAllocator(), &pool);
+
+    // Матрица, освобожденная в другом потоке, возвращается в свой пул
+    std::thread([moved = std::move(second)]() {}).join();
+    ASSERT_EQ(pool.GetCachedBytes(), 640u);
+  }
+  ASSERT_EQ(S21GetAllocator(), S21SystemAllocator());
+
+  // Матрица, созданная в области, освобождается уже после нее
+  S21Matrix outside(1, 1);
+  {
+    S21AllocatorScope scope(&pool);
+    outside = S21Matrix(3, 3);
+  }
+  outside = S21Matrix(2, 2);
+  ASSERT_EQ(pool.GetStats().deallocations, 3);
+  pool.Release();
+  ASSERT_EQ(pool.GetCachedBytes(), 0u);
+
+  // Пул без запаса ничего не хранит
+  S21BufferPool empty(0);
+  S21AllocatorScope scope(&empty);
+  { S21Matrix first(5, 5); }
+  S21Matrix second(5, 5);
+  ASSERT_EQ(empty.GetStats().pool_hits, 0);
+  ASSERT_EQ(empty.GetStats().system_allocations, 2);
+}
+
+// Транспонирование простым циклом для проверки
+template <typename T>
+S21BasicMatrix<T> NaiveTranspose(const S21BasicMatrix<T> &M) {
+  S21BasicMatrix<T> result(M.GetCols(), M.GetRows());
+  for (int i = 0; i < M.GetRows(); i++) {
+    for (int j = 0; j < M.GetCols(); j++) {
+      result(j, i) = M(i, j);
+    }
+  }
+  return result;
+}
+
+TEST(Test_Transpose, blocked_and_in_place) {
+  // Размеры по обе стороны от листа рекурсии и не кратные ему
+  const int sizes[][2] = {{1, 1}, {1, 40}, {16, 17}, {37, 129}, {300, 5},
+                          {64, 64}, {100, 100}};
+  for (const auto &size : sizes) {
+    S21Matrix M(size[0], size[1]);
+    FillMatrix(M, size[0] + size[1]);
+    S21Matrix transposed = M.Transpose();
+    ASSERT_TRUE(transposed == NaiveTranspose(M));
+    S21Matrix copy(M);
+    copy.TransposeInPlace();
+    ASSERT_EQ(copy.GetRows(), size[1]);
+    ASSERT_TRUE(copy == transposed);
+  }
+
+  // Квадратная матрица транспонируется в своем буфере
+  S21BasicMatrix<std::int64_t> square(33, 33);
+  for (int i = 0; i < 33; i++) {
+    for (int j = 0; j < 33; j++) {
+      square(i, j) = 100 * i + j;
+    }
+  }
+  const std::int64_t *buffer = square.data();
+  const int before = g_aligned_allocations;
+  square.TransposeInPlace();
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_EQ(square.data(), buffer);
+  ASSERT_EQ(square(3, 30), 3003);
+  ASSERT_EQ(square(30, 3), 330);
+  square.TransposeInPlace();
+  ASSERT_EQ(square(3, 30), 330);
+}
+
+TEST(Test_Transpose, gemm_consumes_transposed_operands) {
+  const S21Transpose flags[] = {S21Transpose::kNo, S21Transpose::kYes};
+  // Малый размер — простой цикл, большой — блочный алгоритм
+  const int sizes[][3] = {{5, 7, 3}, {83, 71, 97}};
+  for (const auto &size : sizes) {
+    const int m = size[0];
+    const int n = size[1];
+    const int k = size[2];
+    S21Matrix A(m, k);
+    S21Matrix B(k, n);
+    FillMatrix(A, m);
+    FillMatrix(B, n);
+    const S21Matrix expected = A * B;
+    const S21Matrix At = A.Transpose();
+    const S21Matrix Bt = B.Transpose();
+    for (S21Transpose ta : flags) {
+      for (S21Transpose tb : flags) {
+        const S21Matrix &a = ta == S21Transpose::kYes ? At : A;
+        const S21Matrix &b = tb == S21Transpose::kYes ? Bt : B;
+        S21Matrix C(m, n);
+        S21Gemm(ta, tb, m, n, k, a.data(), a.GetStride(), b.data(),
+                b.GetStride(), C.data(), C.GetStride());
+        ASSERT_TRUE(C == expected) << m << " " << static_cast<int>(ta)
+                                   << static_cast<int>(tb);
+      }
+    }
+  }
+
+  // Ленивое транспонирование: память выделяется только под произведение
+  S21Matrix A(120, 90);
+  S21Matrix B(120, 70);
+  FillMatrix(A, 60);
+  FillMatrix(B, 61);
+  const S21Matrix expected = A.Transpose() * B;
+  int before = g_aligned_allocations;
+  S21Matrix product = A.TransposeView() * B;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(product == expected);
+  before = g_aligned_allocations;
+  S21Matrix gram = B.TransposeView() * B.TransposeView().Transpose();
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(gram == B.Transpose() * B);
+
+  // Целые типы: простой цикл с транспонированием
+  S21MatrixI I(3, 2);
+  I(0, 0) = 1;
+  I(1, 1) = 2;
+  I(2, 0) = 3;
+  S21MatrixI gram_i = I.TransposeView() * I;
+  ASSERT_EQ(gram_i(0, 0), 10);
+  ASSERT_EQ(gram_i(1, 1), 4);
+  ASSERT_EQ(gram_i(0, 1), 0);
+}
+
+// Наибольшая по модулю разность элементов матриц одного размера
+double MaxDifference(const S21Matrix &A, const S21Matrix &B) {
+  double result = 0;
+  for (int i = 0; i < A.GetRows(); i++) {
+    for (int j = 0; j < A.GetCols(); j++) {
+      result = std::max(result, std::fabs(A(i, j) - B(i, j)));
+    }
+  }
+  return result;
+}
+
+TEST(Test_Solve, triangular_all_variants) {
+  const int n = 150;
+  // Один столбец, узкий блок и правая часть шире блока решения
+  const int widths[] = {1, 5, 70};
+  const S21Triangle triangles[] = {S21Triangle::kLower, S21Triangle::kUpper};
+  const S21Transpose flags[] = {S21Transpose::kNo, S21Transpose::kYes};
+  for (S21Triangle uplo : triangles) {
+    for (S21Transpose trans : flags) {
+      for (bool unit : {false, true}) {
+        // Во втором треугольнике и (при unit) на диагонали — мусор,
+        // который решение читать не должно
+        S21Matrix A(n, n);
+        S21Matrix T(n, n);
+        FillMatrix(A, 70);
+        for (int i = 0; i < n; i++) {
+          for (int j = 0; j < n; j++) {
+            const bool inside =
+                uplo == S21Triangle::kLower ? j < i : j > i;
+            if (i == j) {
+              T(i, j) = unit ? 1 : 2 + std::fabs(A(i, j));
+              A(i, j) = unit ? 1e6 : T(i, j);
+            } else if (inside) {
+              A(i, j) /= n;
+              T(i, j) = A(i, j);
+            } else {
+              A(i, j) = 1e6;
+            }
+          }
+        }
+        S21Matrix op = trans == S21Transpose::kYes ? T.Transpose() : T;
+        for (int m : widths) {
+          S21Matrix X(n, m);
+          FillMatrix(X, m);
+          S21Matrix B = op * X;
+          S21SolveTriangular(uplo, trans, unit, n, m, A.data(),
+                             A.GetStride(), B.data(), B.GetStride());
+          ASSERT_LT(MaxDifference(B, X), 1e-12)
+              << static_cast<int>(uplo) << static_cast<int>(trans) << unit
+              << " m=" << m;
+        }
+      }
+    }
+  }
+}
+
+TEST(Test_Solve, factorizations_agree) {
+  const int n = 90;
+  S21Matrix M(n, n);
+  FillMatrix(M, 71);
+  // M^T * M + n * E — симметричная положительно определенная
+  S21Matrix A = M.TransposeView() * M;
+  for (int i = 0; i < n; i++) {
+    A(i, i) += n;
+  }
+  S21Matrix B(n, 7);
+  FillMatrix(B, 72);
+
+  S21LU lu(A);
+  S21Cholesky cholesky(A);
+  S21QR qr(A);
+  const S21Matrix X = lu.Solve(B);
+  ASSERT_LT(MaxDifference(A * X, B), 1e-10);
+  ASSERT_LT(MaxDifference(cholesky.Solve(B), X), 1e-10);
+  ASSERT_LT(MaxDifference(qr.Solve(B), X), 1e-10);
+  ASSERT_LT(MaxDifference(A.Solve(B), X), 1e-10);
+  ASSERT_NEAR(cholesky.Determinant() / lu.Determinant(), 1, 1e-9);
+
+  // L * L^T = A, над диагональю L нули
+  const S21Matrix &L = cholesky.GetL();
+  S21Matrix LLt = L * L.TransposeView();
+  ASSERT_LT(MaxDifference(LLt, A), 1e-10);
+  ASSERT_EQ(L(0, n - 1), 0);
+
+  // Векторная правая часть совпадает со столбцом матричной
+  std::vector<double> b(n);
+  for (int i = 0; i < n; i++) {
+    b[i] = B(i, 3);
+  }
+  const std::vector<double> x_lu = lu.Solve(b);
+  const std::vector<double> x_cholesky = cholesky.Solve(b);
+  const std::vector<double> x_qr = qr.Solve(b);
+  const std::vector<double> x = A.Solve(b);
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(x_lu[i], X(i, 3), 1e-10);
+    ASSERT_NEAR(x_cholesky[i], X(i, 3), 1e-10);
+    ASSERT_NEAR(x_qr[i], X(i, 3), 1e-10);
+    ASSERT_NEAR(x[i], X(i, 3), 1e-10);
+  }
+
+  // float: те же алгоритмы с векторными ядрами другой ширины
+  S21MatrixF Af(n, n);
+  S21MatrixF Bf(n, 2);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      Af(i, j) = static_cast<float>(A(i, j));
+    }
+    Bf(i, 0) = static_cast<float>(B(i, 0));
+    Bf(i, 1) = static_cast<float>(B(i, 1));
+  }
+  const S21MatrixF Xf = S21BasicCholesky<float>(Af).Solve(Bf);
+  for (int i = 0; i < n; i++) {
+    ASSERT_NEAR(Xf(i, 0), X(i, 0), 1e-4);
+  }
+}
+
+TEST(Test_Solve, least_squares) {
+  const int m = 200;
+  const int n = 30;
+  S21Matrix A(m, n);
+  S21Matrix B(m, 3);
+  FillMatrix(A, 73);
+  FillMatrix(B, 74);
+  S21QR qr(A);
+  ASSERT_TRUE(qr.IsFullRank());
+  const S21Matrix X = qr.Solve(B);
+  ASSERT_EQ(X.GetRows(), n);
+  ASSERT_EQ(X.GetCols(), 3);
+  // Невязка ортогональна столбцам A: A^T * (A * X - B) = 0
+  S21Matrix residual = A * X - B;
+  S21Matrix normal = A.TransposeView() * residual;
+  ASSERT_LT(MaxDifference(normal, S21Matrix(n, 3)), 1e-10);
+  ASSERT_LT(MaxDifference(A.Solve(B), X), 1e-12);
+
+  // R из QR совпадает с L^T из Холецкого для A^T * A с точностью до
+  // знаков строк
+  S21Matrix gram = A.TransposeView() * A;
+  const S21Matrix R = qr.GetR();
+  const S21Cholesky cholesky(gram);
+  const S21Matrix &L = cholesky.GetL();
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_NEAR(std::fabs(R(i, j)), std::fabs(L(j, i)), 1e-10);
+    }
+  }
+
+  // Переопределенная система с точным решением
+  S21Matrix x_true(n, 1);
+  FillMatrix(x_true, 75);
+  S21Matrix exact = A * x_true;
+  ASSERT_LT(MaxDifference(qr.Solve(exact), x_true), 1e-12);
+}
+
+TEST(Test_Solve, errors) {
+  S21Matrix A(4, 4);
+  FillMatrix(A, 76);
+  ASSERT_THROW(A.Solve(S21Matrix(3, 1)), std::invalid_argument);
+  ASSERT_THROW(A.Solve(std::vector<double>(5)), std::invalid_argument);
+  ASSERT_THROW(S21Matrix(3, 4).Solve(S21Matrix(3, 1)), std::invalid_argument);
+  ASSERT_THROW(S21MatrixI(2, 2).Solve(S21MatrixI(2, 1)),
+               std::invalid_argument);
+  ASSERT_THROW(S21Matrix(4, 4).Solve(S21Matrix(4, 1)), std::invalid_argument);
+
+  // Не положительно определенная и неквадратная
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = 1;
+  indefinite(1, 1) = -1;
+  ASSERT_THROW(S21Cholesky{indefinite}, std::invalid_argument);
+  ASSERT_THROW(S21Cholesky(S21Matrix(2, 3)), std::invalid_argument);
+
+  // Недоопределенная и неполного ранга
+  ASSERT_THROW(S21QR(S21Matrix(2, 3)), std::invalid_argument);
+  S21Matrix deficient(5, 3);
+  FillMatrix(deficient, 77);
+  for (int i = 0; i < 5; i++) {
+    deficient(i, 2) = deficient(i, 0) - deficient(i, 1);
+  }
+  S21QR qr(deficient);
+  ASSERT_FALSE(qr.IsFullRank());
+  ASSERT_THROW(qr.Solve(S21Matrix(5, 1)), std::invalid_argument);
+  ASSERT_THROW(deficient.Solve(S21Matrix(5, 1)), std::invalid_argument);
+}
+
+TEST(Test_Vector, construct_copy_move) {
+  S21Vector v(5);
+  ASSERT_EQ(v.GetSize(), 5);
+  ASSERT_EQ(v(4), 0);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) %
+                S21Vector::kAlignment,
+            0u);
+  ASSERT_THROW(S21Vector(0), std::invalid_argument);
+  ASSERT_THROW(v(5), std::out_of_range);
+
+  S21Vector w(std::vector<double>{1, 2, 3});
+  ASSERT_EQ(w[2], 3);
+  S21Vector copy(w);
+  copy[0] = 10;
+  ASSERT_EQ(w[0], 1);
+  // Присваивание вектора того же размера не выделяет память
+  const int before = g_aligned_allocations;
+  w = copy;
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_EQ(w[0], 10);
+  S21Vector moved(std::move(copy));
+  ASSERT_EQ(copy.GetSize(), 0);
+  ASSERT_EQ(copy.data(), nullptr);
+  ASSERT_EQ(moved[1], 2);
+  v = std::move(moved);
+  ASSERT_EQ(v.GetSize(), 3);
+  double sum = 0;
+  for (double value : v) {
+    sum += value;
+  }
+  ASSERT_EQ(sum, 15);
+}
+
+TEST(Test_Vector, gemv_ger_match_matrix_product) {
+  // Нечетные размеры: хвосты векторных ядер
+  const int sizes[][2] = {{1, 1}, {7, 13}, {130, 67}, {300, 301}};
+  for (const auto &size : sizes) {
+    const int m = size[0];
+    const int n = size[1];
+    S21Matrix A(m, n);
+    S21Matrix X(n, 1);
+    S21Matrix Z(m, 1);
+    FillMatrix(A, m);
+    FillMatrix(X, n);
+    FillMatrix(Z, m + n);
+    S21Vector x(n);
+    S21Vector z(m);
+    for (int i = 0; i < n; i++) x[i] = X(i, 0);
+    for (int i = 0; i < m; i++) z[i] = Z(i, 0);
+
+    // y = 2 * A * x - 3 * y
+    S21Matrix expected = A * X * 2.0 - Z * 3.0;
+    S21Vector y(z);
+    S21Gemv(S21Transpose::kNo, 2.0, A, x, -3.0, &y);
+    for (int i = 0; i < m; i++) {
+      ASSERT_NEAR(y[i], expected(i, 0), 1e-12) << m << "x" << n;
+    }
+    S21Vector product = A * x;
+    for (int i = 0; i < m; i++) {
+      ASSERT_NEAR(product[i], (A * X)(i, 0), 1e-12);
+    }
+
+    // A^T * z при beta = 0: прежние значения (здесь NaN) не читаются
+    S21Matrix expected_t = A.TransposeView() * Z;
+    S21Vector y_t(n);
+    for (double &value : y_t) {
+      value = std::numeric_limits<double>::quiet_NaN();
+    }
+    S21Gemv(S21Transpose::kYes, 1.0, A, z, 0.0, &y_t);
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(y_t[i], expected_t(i, 0), 1e-12);
+    }
+
+    // A += 0.5 * z * x^T
+    S21Matrix updated = A + Z * X.Transpose() * 0.5;
+    S21Ger(0.5, z, x, &A);
+    ASSERT_TRUE(A == updated);
+  }
+
+  S21Matrix A(3, 4);
+  S21Vector y(3);
+  ASSERT_THROW(S21Gemv(S21Transpose::kNo, 1.0, A, S21Vector(3), 0.0, &y),
+               std::invalid_argument);
+  ASSERT_THROW(S21Gemv(S21Transpose::kYes, 1.0, A, S21Vector(3), 0.0, &y),
+               std::invalid_argument);
+  ASSERT_THROW(S21Ger(1.0, S21Vector(4), S21Vector(3), &A),
+               std::invalid_argument);
+}
+
+TEST(Test_Vector, axpy_dot_and_power_iteration) {
+  S21Vector x(std::vector<double>{1, 2, 3, 4, 5});
+  S21Vector y(std::vector<double>{1, 1, 1, 1, 1});
+  S21Axpy(2.0, x, &y);
+  ASSERT_EQ(y[4], 11);
+  ASSERT_EQ(S21Dot(x, y), 1 * 3 + 2 * 5 + 3 * 7 + 4 * 9 + 5 * 11);
+  ASSERT_THROW(S21Dot(x, S21Vector(4)), std::invalid_argument);
+  S21Vector short_y(4);
+  ASSERT_THROW(S21Axpy(1.0, x, &short_y), std::invalid_argument);
+
+  // Целые векторы: простые циклы
+  S21MatrixI I(2, 3);
+  I(0, 0) = 1;
+  I(0, 2) = 2;
+  I(1, 1) = 3;
+  S21VectorI v(std::vector<int>{1, 2, 3});
+  S21VectorI w = I * v;
+  ASSERT_EQ(w[0], 7);
+  ASSERT_EQ(w[1], 6);
+
+  // Степенной метод без выделений памяти на итерации: наибольшее
+  // собственное значение diag(1, ..., n) равно n
+  const int n = 50;
+  S21Matrix D(n, n);
+  for (int i = 0; i < n; i++) {
+    D(i, i) = i + 1;
+  }
+  S21Vector q(std::vector<double>(n, 1.0));
+  S21Vector next(n);
+  const int before = g_aligned_allocations;
+  double lambda = 0;
+  for (int iteration = 0; iteration < 400; iteration++) {
+    S21Gemv(S21Transpose::kNo, 1.0, D, q, 0.0, &next);
+    lambda = S21Dot(q, next) / S21Dot(q, q);
+    std::swap(q, next);
+    const double norm = std::sqrt(S21Dot(q, q));
+    for (double &value : q) {
+      value /= norm;
+    }
+  }
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_NEAR(lambda, n, 1e-6);
+}
+
+TEST(Test_Pow, matches_repeated_multiplication) {
+  S21Matrix A(6, 6);
+  FillMatrix(A, 80);
+  S21Matrix expected(6, 6);
+  for (int i = 0; i < 6; i++) {
+    expected(i, i) = 1;
+  }
+  for (int k = 0; k <= 13; k++) {
+    ASSERT_TRUE(A.Pow(k) == expected) << k;
+    expected *= A;
+  }
+  // Отрицательная степень — степень обратной
+  S21Matrix inverse_cube = A.Pow(-3);
+  ASSERT_TRUE(inverse_cube * A.Pow(3) == A.Pow(0));
+  ASSERT_THROW(S21Matrix(2, 3).Pow(2), std::invalid_argument);
+  ASSERT_THROW(S21Matrix(2, 2).Pow(-1), std::invalid_argument);
+
+  // Целые степени точны: [[1, 1], [1, 0]]^k = [[F(k+1), F(k)], ...]
+  S21MatrixI64 fibonacci(2, 2);
+  fibonacci(0, 0) = 1;
+  fibonacci(0, 1) = 1;
+  fibonacci(1, 0) = 1;
+  S21MatrixI64 f90 = fibonacci.Pow(90);
+  ASSERT_EQ(f90(0, 1), 2880067194370816120LL);
+  ASSERT_EQ(f90(0, 0), 4660046610375530309LL);
+}
+
+TEST(Test_Pow, allocations_do_not_depend_on_exponent) {
+  // Стохастическая матрица: степени остаются ограниченными
+  S21Matrix P(40, 40);
+  for (int i = 0; i < 40; i++) {
+    P(i, i) = 0.5;
+    P(i, (i + 1) % 40) = 0.5;
+  }
+  int before = g_aligned_allocations;
+  S21Matrix small = P.Pow(3);
+  const int small_allocations = g_aligned_allocations - before;
+  before = g_aligned_allocations;
+  S21Matrix large = P.Pow(1000001);
+  ASSERT_EQ(g_aligned_allocations - before, small_allocations);
+  ASSERT_LE(small_allocations, 3);
+  // Цепочка сходится к равномерному распределению
+  ASSERT_NEAR(large(7, 31), 1.0 / 40, 1e-12);
+}
+
+TEST(Test_Pow, strassen_workspace_is_shared) {
+  const int saved_crossover = S21GetStrassenCrossover();
+  const int saved_threshold = S21GetStrassenThreshold();
+  S21Matrix P(100, 100);
+  for (int i = 0; i < 100; i++) {
+    P(i, i) = 0.5;
+    P(i, (i + 1) % 100) = 0.5;
+  }
+  S21Matrix A(100, 100);
+  FillMatrix(A, 82);
+  A.MulNumber(0.01);
+  const S21Matrix classic_power = P.Pow(37);
+  const S21Matrix classic_exp = A.Expm();
+
+  // Произведения идут через Штрассена; рабочая память выделяется один
+  // раз на вызов, а не на каждое произведение
+  S21SetStrassenCrossover(16);
+  S21SetStrassenThreshold(64);
+  int before = g_aligned_allocations;
+  S21Matrix small = P.Pow(3);
+  const int small_allocations = g_aligned_allocations - before;
+  before = g_aligned_allocations;
+  S21Matrix power = P.Pow(37);
+  ASSERT_EQ(g_aligned_allocations - before, small_allocations);
+  ASSERT_LE(small_allocations, 4);
+  ASSERT_TRUE(power == classic_power);
+
+  before = g_aligned_allocations;
+  S21Matrix exp = A.Expm();
+  const int exp_allocations = g_aligned_allocations - before;
+  S21Matrix scaled = A * 64.0;
+  before = g_aligned_allocations;
+  scaled.Expm();
+  ASSERT_EQ(g_aligned_allocations - before, exp_allocations);
+  ASSERT_TRUE(exp == classic_exp);
+  S21SetStrassenThreshold(saved_threshold);
+  S21SetStrassenCrossover(saved_crossover);
+}
+
+TEST(Test_Expm, known_exponentials) {
+  // Диагональная: экспоненты элементов, в том числе с масштабированием
+  S21Matrix D(3, 3);
+  D(0, 0) = 1;
+  D(1, 1) = -2;
+  D(2, 2) = 7.5;
+  S21Matrix eD = D.Expm();
+  ASSERT_NEAR(eD(0, 0) / std::exp(1.0), 1, 1e-14);
+  ASSERT_NEAR(eD(1, 1) / std::exp(-2.0), 1, 1e-14);
+  ASSERT_NEAR(eD(2, 2) / std::exp(7.5), 1, 1e-14);
+  ASSERT_EQ(eD(0, 1), 0);
+
+  // Нильпотентная: e^N = E + N
+  S21Matrix N(2, 2);
+  N(0, 1) = 3;
+  S21Matrix eN = N.Expm();
+  ASSERT_NEAR(eN(0, 0), 1, 1e-15);
+  ASSERT_NEAR(eN(0, 1), 3, 1e-14);
+  ASSERT_NEAR(eN(1, 0), 0, 1e-15);
+
+  // Генератор поворота: e^(t J) — поворот на угол t
+  const double t = 10;
+  S21Matrix J(2, 2);
+  J(0, 1) = -t;
+  J(1, 0) = t;
+  S21Matrix rotation = J.Expm();
+  ASSERT_NEAR(rotation(0, 0), std::cos(t), 1e-13);
+  ASSERT_NEAR(rotation(1, 0), std::sin(t), 1e-13);
+  ASSERT_NEAR(rotation(0, 1), -std::sin(t), 1e-13);
+
+  // e^A * e^-A = E для плотной матрицы
+  S21Matrix A(30, 30);
+  FillMatrix(A, 81);
+  S21Matrix minus_A = A * -1.0;
+  S21Matrix product = A.Expm() * minus_A.Expm();
+  ASSERT_TRUE(product == A.Pow(0));
+
+  // long double: порядок Паде выше
+  S21MatrixLD L(1, 1);
+  L(0, 0) = 1;
+  ASSERT_NEAR(static_cast<double>(L.Expm()(0, 0) / std::exp(1.0L) - 1), 0,
+              1e-18);
+
+  ASSERT_THROW(S21Matrix(2, 3).Expm(), std::invalid_argument);
+  ASSERT_THROW(S21MatrixI(2, 2).Expm(), std::invalid_argument);
+  S21Matrix bad(2, 2);
+  bad(0, 0) = std::numeric_limits<double>::infinity();
+  ASSERT_THROW(bad.Expm(), std::invalid_argument);
+}
+
+TEST(Test_SmallOrder, closed_forms_match_general_algorithms) {
+  for (int n = 1; n <= 4; n++) {
+    S21Matrix A(n, n);
+    FillMatrix(A, 90 + n);
+    ASSERT_NEAR(A.Determinant(), S21LU(A).Determinant(), 1e-14) << n;
+    if (n > 1) {
+      ASSERT_TRUE(A.CalcComplements() == CofactorsByMinors(A)) << n;
+    }
+    // Обратная — одно выделение памяти под результат
+    const int before = g_aligned_allocations;
+    S21Matrix inverse = A.InverseMatrix();
+    ASSERT_EQ(g_aligned_allocations - before, 1);
+    ASSERT_TRUE(inverse == S21LU(A).Inverse()) << n;
+  }
+
+  // Вырожденная 4x4: дополнения точны, обратной нет
+  S21Matrix S(4, 4);
+  FillMatrix(S, 95);
+  for (int j = 0; j < 4; j++) {
+    S(3, j) = S(0, j) - 2 * S(1, j);
+  }
+  ASSERT_TRUE(S.CalcComplements() == CofactorsByMinors(S));
+  S21Matrix Z(4, 4);
+  ASSERT_EQ(Z.Determinant(), 0);
+  ASSERT_THROW(Z.InverseMatrix(), std::invalid_argument);
+
+  // Целые 4x4: точный определитель и обратная при det = 1
+  S21MatrixI I(4, 4);
+  const int values[4][4] = {
+      {2, 1, 0, 0}, {1, 1, 0, 0}, {0, 0, 3, 2}, {0, 0, 1, 1}};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      I(i, j) = values[i][j];
+    }
+  }
+  ASSERT_EQ(I.Determinant(), 1);
+  S21MatrixI inverse_i = I.InverseMatrix();
+  ASSERT_EQ(inverse_i(0, 1), -1);
+  ASSERT_EQ(inverse_i(2, 3), -2);
+  ASSERT_EQ(inverse_i(3, 3), 3);
+  I(0, 0) = 3;
+  ASSERT_EQ(I.Determinant(), 2);
+  ASSERT_THROW(I.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(Test_SmallOrder, empty_matrix_skips_closed_forms) {
+  // Пустая матрица после перемещения не попадает в явные формулы
+  S21Matrix A(3, 3);
+  S21Matrix B(std::move(A));
+  ASSERT_EQ(A.Determinant(), 0);
+  ASSERT_THROW(A.CalcComplements(), std::invalid_argument);
+  ASSERT_THROW(A.InverseMatrix(), std::invalid_argument);
+
+  S21MatrixI I(2, 2);
+  S21MatrixI J(std::move(I));
+  ASSERT_EQ(I.Determinant(), 0);
+  ASSERT_THROW(I.CalcComplements(), std::invalid_argument);
+  ASSERT_THROW(I.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(Test_Cache, repeated_queries_reuse_results) {
+  S21Matrix A(8, 8);
+  FillMatrix(A, 101);
+  ASSERT_FALSE(A.IsCacheEnabled());
+  A.EnableCache();
+  ASSERT_TRUE(A.IsCacheEnabled());
+
+  const double det = A.Determinant();
+  const S21Matrix inverse = A.InverseMatrix();
+  const std::vector<double> b = {1, 2, 3, 4, 5, 6, 7, 8};
+  const std::vector<double> x = A.Solve(b);
+  const double norm = A.Norm();
+
+  // Повторные запросы не считают заново: определитель и решение без
+  // новых матриц, обратная — только копия результата
+  int before = g_aligned_allocations;
+  ASSERT_EQ(A.Determinant(), det);
+  ASSERT_EQ(A.Norm(), norm);
+  ASSERT_EQ(A.Solve(b), x);
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  before = g_aligned_allocations;
+  ASSERT_TRUE(A.InverseMatrix() == inverse);
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+
+  // Результаты совпадают с матрицей без кэша
+  S21Matrix plain(A);
+  ASSERT_FALSE(plain.IsCacheEnabled());
+  ASSERT_EQ(plain.Determinant(), det);
+  ASSERT_TRUE(plain.InverseMatrix() == inverse);
+  ASSERT_EQ(plain.Solve(b), x);
+
+  // Константный доступ версию не меняет
+  const S21Matrix &view = A;
+  const unsigned long long version = A.GetVersion();
+  double sum = view(0, 0) + view.row(1)[2] + view.data()[3];
+  (void)sum;
+  ASSERT_EQ(A.GetVersion(), version);
+
+  A.EnableCache(false);
+  ASSERT_FALSE(A.IsCacheEnabled());
+  ASSERT_EQ(A.Determinant(), det);
+}
+
+TEST(Test_Cache, mutations_invalidate) {
+  S21Matrix A(6, 6);
+  FillMatrix(A, 102);
+  for (int i = 0; i < 6; i++) {
+    A(i, i) += 6;
+  }
+  S21Matrix B(6, 6);
+  FillMatrix(B, 103);
+  A.EnableCache();
+
+  // После каждого изменения кэшированные величины совпадают с
+  // посчитанными заново на копии без кэша
+  auto check = [](S21Matrix &M) {
+    const unsigned long long version = M.GetVersion();
+    M.Determinant();
+    M.Norm();
+    S21Matrix plain(M);
+    ASSERT_EQ(M.GetVersion(), version);
+    ASSERT_EQ(M.Determinant(), plain.Determinant());
+    ASSERT_EQ(M.Norm(), plain.Norm());
+    if (M.GetRows() == M.GetCols()) {
+      ASSERT_TRUE(M.InverseMatrix() == plain.InverseMatrix());
+    }
+  };
+  std::vector<std::function<void(S21Matrix &)>> mutations = {
+      [](S21Matrix &M) { M(1, 2) += 3; },
+      [&B](S21Matrix &M) { M += B; },
+      [&B](S21Matrix &M) { M -= B; },
+      [](S21Matrix &M) { M *= 0.5; },
+      [&B](S21Matrix &M) { M *= B; },
+      [&B](S21Matrix &M) { M.SumMatrix(B); },
+      [&B](S21Matrix &M) { M.SubMatrix(B); },
+      [&B](S21Matrix &M) { M = M + B * 2.0; },
+      [](S21Matrix &M) { M.TransposeInPlace(); },
+      [](S21Matrix &M) { M.data()[7] = -4; },
+      [](S21Matrix &M) { M.row(3)[0] = 9; },
+      [&B](S21Matrix &M) { M = B; },
+      [](S21Matrix &M) { M = S21Matrix(M); },
+      [](S21Matrix &M) {
+        M.SetRows(7);
+        M.SetCols(7);
+        M(6, 6) = 1;
+      },
+  };
+  for (auto &mutate : mutations) {
+    check(A);
+    const unsigned long long version = A.GetVersion();
+    mutate(A);
+    ASSERT_GT(A.GetVersion(), version);
+    ASSERT_TRUE(A.IsCacheEnabled());
+    check(A);
+  }
+
+  // Запись через указатель, полученный раньше запроса, требует
+  // явного сброса
+  double *raw = A.data();
+  const double det = A.Determinant();
+  raw[0] += 1;
+  ASSERT_EQ(A.Determinant(), det);
+  A.InvalidateCache();
+  ASSERT_EQ(A.Determinant(), S21Matrix(A).Determinant());
+
+  // Целые матрицы кэшируют определитель и обратную
+  S21MatrixI I(5, 5);
+  for (int i = 0; i < 5; i++) {
+    I(i, i) = 1;
+    if (i + 1 < 5) {
+      I(i, i + 1) = 2;
+    }
+  }
+  I.EnableCache();
+  ASSERT_EQ(I.Determinant(), 1);
+  ASSERT_EQ(I.InverseMatrix()(0, 1), -2);
+  I(4, 4) = 3;
+  ASSERT_EQ(I.Determinant(), 3);
+  ASSERT_THROW(I.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(Test_CopyOnWrite, copies_share_until_write) {
+  S21Matrix A(64, 64);
+  FillMatrix(A, 110);
+  ASSERT_FALSE(A.IsCopyOnWrite());
+  A.EnableCopyOnWrite();
+  ASSERT_TRUE(A.IsCopyOnWrite());
+  ASSERT_FALSE(A.IsShared());
+  S21Matrix original(A);
+  original.EnableCopyOnWrite(false);
+
+  // Копия не выделяет память и разделяет буфер
+  int before = g_aligned_allocations;
+  S21Matrix B(A);
+  S21Matrix C = B;
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_TRUE(B.IsCopyOnWrite());
+  ASSERT_TRUE(A.IsShared());
+  ASSERT_EQ(static_cast<const S21Matrix &>(A).data(),
+            static_cast<const S21Matrix &>(C).data());
+
+  // Чтение буфер не отделяет
+  const S21Matrix &read = B;
+  ASSERT_EQ(read(3, 4), original(3, 4));
+  ASSERT_TRUE(B == original);
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+  ASSERT_EQ(B.Determinant(), original.Determinant());
+  ASSERT_TRUE(B.IsShared());
+
+  // Первая запись копирует буфер один раз
+  before = g_aligned_allocations;
+  B(3, 4) = 100;
+  B(5, 6) = 200;
+  ASSERT_EQ(g_aligned_allocations - before, 1);
+  ASSERT_TRUE(A == original);
+  ASSERT_TRUE(C == original);
+  ASSERT_EQ(B(3, 4), 100);
+  ASSERT_TRUE(A.IsShared());
+
+  // Последняя копия пишет в буфер без копирования
+  C = S21Matrix(2, 2);
+  ASSERT_FALSE(A.IsShared());
+  before = g_aligned_allocations;
+  A(0, 0) = -1;
+  ASSERT_EQ(g_aligned_allocations - before, 0);
+
+  // Выключение режима отделяет разделенный буфер
+  S21Matrix D(A);
+  D.EnableCopyOnWrite(false);
+  ASSERT_FALSE(D.IsCopyOnWrite());
+  ASSERT_FALSE(A.IsShared());
+  D(0, 0) = 5;
+  ASSERT_EQ(A(0, 0), -1);
+  S21Matrix E(D);
+  ASSERT_FALSE(E.IsCopyOnWrite());
+}
+
+TEST(Test_CopyOnWrite, mutations_leave_other_copies_intact) {
+  S21Matrix A(6, 6);
+  FillMatrix(A, 111);
+  for (int i = 0; i < 6; i++) {
+    A(i, i) += 6;
+  }
+  S21Matrix B(6, 6);
+  FillMatrix(B, 112);
+  A.EnableCopyOnWrite();
+
+  std::vector<std::function<void(S21Matrix &)>> mutations = {
+      [](S21Matrix &M) { M(1, 2) += 3; },
+      [&B](S21Matrix &M) { M += B; },
+      [&B](S21Matrix &M) { M -= B; },
+      [](S21Matrix &M) { M *= 0.5; },
+      [&B](S21Matrix &M) { M *= B; },
+      [&B](S21Matrix &M) { M = M + B * 2.0; },
+      [](S21Matrix &M) { M.TransposeInPlace(); },
+      [](S21Matrix &M) { M.data()[7] = -4; },
+      [](S21Matrix &M) { M.row(3)[0] = 9; },
+      [&B](S21Matrix &M) { M = B; },
+      [](S21Matrix &M) { M = S21Matrix(6, 6); },
+      [](S21Matrix &M) { M.SetRows(7); },
+      [](S21Matrix &M) { M.SetCols(7); },
+  };
+  for (auto &mutate : mutations) {
+    S21Matrix copy(A);
+    S21Matrix plain(A);
+    plain.EnableCopyOnWrite(false);
+    ASSERT_TRUE(copy.IsShared());
+    mutate(copy);
+    mutate(plain);
+    ASSERT_TRUE(A.IsCopyOnWrite());
+    ASSERT_TRUE(copy.IsCopyOnWrite());
+    ASSERT_FALSE(A.IsShared());
+    ASSERT_TRUE(copy == plain);
+  }
+
+  // Вычисления над копиями пишут только в свои буферы
+  {
+    S21Matrix saved(A);
+    saved.EnableCopyOnWrite(false);
+    S21Matrix copy(A);
+    ASSERT_NEAR(copy.Determinant(), saved.Determinant(), 1e-9);
+    ASSERT_TRUE(copy.InverseMatrix() == saved.InverseMatrix());
+    ASSERT_TRUE(copy.CalcComplements() == saved.CalcComplements());
+    ASSERT_TRUE(copy.Pow(3) == saved.Pow(3));
+    ASSERT_TRUE(copy.Expm() == saved.Expm());
+    ASSERT_TRUE(copy.Transpose() == saved.Transpose());
+    ASSERT_TRUE(S21LU(copy).Inverse() == S21LU(saved).Inverse());
+    ASSERT_TRUE(copy.Solve(B) == saved.Solve(B));
+    ASSERT_TRUE(A == saved);
+    ASSERT_TRUE(copy.IsShared());
+  }
+
+  // Целый определитель методом Барейса пишет в рабочую копию
+  S21MatrixI I(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      I(i, j) = (i * 7 + j * 3) % 5 + (i == j ? 4 : 0);
+    }
+  }
+  S21MatrixI I_saved(I);
+  I.EnableCopyOnWrite();
+  S21MatrixI I_copy(I);
+  ASSERT_EQ(I_copy.Determinant(), I_saved.Determinant());
+  ASSERT_TRUE(I == I_saved);
+
+  // Присваивание: в матрицу с режимом буфер разделяется, в обычную
+  // элементы копируются
+  S21Matrix target(2, 2);
+  target = A;
+  ASSERT_FALSE(target.IsCopyOnWrite());
+  ASSERT_FALSE(A.IsShared());
+  target.EnableCopyOnWrite();
+  target = A;
+  ASSERT_TRUE(A.IsShared());
+  target = B;
+  ASSERT_TRUE(target.IsCopyOnWrite());
+  ASSERT_FALSE(A.IsShared());
+  S21Matrix moved(A);
+  S21Matrix receiver(std::move(moved));
+  ASSERT_TRUE(receiver.IsCopyOnWrite());
+  ASSERT_TRUE(A.IsShared());
+}
+
+TEST(Test_CopyOnWrite, concurrent_readers) {
+  S21Matrix A(32, 32);
+  FillMatrix(A, 113);
+  A.EnableCopyOnWrite();
+  const double sum = [&A] {
+    double total = 0;
+    for (double value : static_cast<const S21Matrix &>(A).row(5)) {
+      total += value;
+    }
+    return total;
+  }();
+
+  // Потоки копируют общую матрицу, читают копии, пишут в свои копии и
+  // уничтожают их; счетчик владельцев остается согласованным
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches{0};
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&A, &mismatches, sum, t] {
+      for (int iteration = 0; iteration < 200; iteration++) {
+        S21Matrix copy(A);
+        double total = 0;
+        for (double value : static_cast<const S21Matrix &>(copy).row(5)) {
+          total += value;
+        }
+        if (total != sum) {
+          ++mismatches;
+        }
+        if (iteration % 10 == t) {
+          copy(5, 0) += 1;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(mismatches, 0);
+  ASSERT_FALSE(A.IsShared());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();